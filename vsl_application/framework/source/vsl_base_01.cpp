@@ -226,6 +226,62 @@ HRESULT Base_01::Fw_SetupDX(LPDIRECT3DDEVICE9 device)
 				}
 		}
 
+	// --- ? flat mesh optimise (reports ACMR before & after)
+		if (FALSE)
+		{
+			vs_library::DotObjMesh mesh;
+			vs_library::DotObjUtilities dot_obj_utilities;
+			CHAR *filename = "object\\teapot\\teapot_vn.obj";
+			HRESULT hr = dot_obj_utilities.Read(&mesh, filename);
+			if (SUCCEEDED(hr))
+			{
+				dot_obj_utilities.OptimiseMesh(&mesh);
+			}
+		}
+
+	// --- ? parse benchmarks (synthetic 10M face grid)
+		if (FALSE)
+		{
+			vs_library::DotObjUtilities dot_obj_utilities;
+			dot_obj_utilities.BenchmarkScan(10000000);
+			dot_obj_utilities.BenchmarkParse(10000000, 0);
+		}
+
+	// --- ? element tree load & unload benchmark (synthetic ~1M vertex grid)
+		if (FALSE)
+		{
+			vs_library::DotObjUtilities dot_obj_utilities;
+			dot_obj_utilities.BenchmarkElement(2000000);
+		}
+
+	// --- ? write benchmark (synthetic 10M face grid, temporary file)
+		if (FALSE)
+		{
+			vs_library::DotObjUtilities dot_obj_utilities;
+			dot_obj_utilities.BenchmarkWrite(10000000, "object\\benchmark_write.obj");
+		}
+
+	// --- ? bvh build & ray cast benchmark (synthetic 1M face grid)
+		if (FALSE)
+		{
+			vs_library::DotObjUtilities dot_obj_utilities;
+			dot_obj_utilities.BenchmarkBvh(1000000, 100000);
+		}
+
+	// --- ? lod generation benchmark (synthetic 1M face grid, 6 lods)
+		if (FALSE)
+		{
+			vs_library::DotObjUtilities dot_obj_utilities;
+			dot_obj_utilities.BenchmarkLods(1000000, 6);
+		}
+
+	// --- ? vertex packing benchmark (synthetic 1M face grid)
+		if (FALSE)
+		{
+			vs_library::DotObjUtilities dot_obj_utilities;
+			dot_obj_utilities.BenchmarkPacking(1000000);
+		}
+
 	return SUCCESS_OK;
 }
 
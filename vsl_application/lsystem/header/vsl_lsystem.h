@@ -22,6 +22,9 @@
 // ---- application include
 	#include "../../vsl_application/shared/header/vsl_fvf_vertex_structs.h"
 
+// ---- simd include
+	#include <xmmintrin.h>   // SSE
+
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -78,12 +81,81 @@ namespace vsl_application
 
 
 		// ---- lsystem methods
-			VOID Lsystem_ReadTextfile(CHAR *filename);
+			VOID Lsystem_ReadTextfile(const CHAR *filename);
 			VOID Lsystem_Iterate(INT counter);
+			VOID Lsystem_Rewrite(const std::string &from, std::string *to);
+			VOID Lsystem_SetDepth(INT depth);
 			VOID Lsystem_DrawTree();
+			UINT64  Lsystem_GetVertexCount();
+			HRESULT Lsystem_DrawTreeToBuffer(LVertex *buffer, UINT64 number_of_vertices);
 			VOID Lsystem_Fog(LPDIRECT3DDEVICE9 device);
 			VOID Lsystem_SelectVariable(INT var);
 
+		// ---- lsystem benchmark (see vsl_lsystem_benchmark.hpp)
+			HRESULT Lsystem_BenchmarkIterate(INT max_depth, INT max_length);
+			HRESULT Lsystem_BenchmarkStream(INT extra_depth);
+			HRESULT Lsystem_BenchmarkDraw(INT extra_depth, INT max_threads);
+			HRESULT Lsystem_BenchmarkTurtle(INT max_length);
+			HRESULT Lsystem_BenchmarkHeadless(const CHAR *filename, INT depth);
+			HRESULT Lsystem_BenchmarkCommandLine(const CHAR *command_line, INT *exit_code);
+			HRESULT Lsystem_BenchmarkIndexed(INT extra_depth);
+			HRESULT Lsystem_BenchmarkDepth(INT extra_depth);
+
+
+		// ---- lsystem expansion mode
+			enum ExpandMode
+			{
+				STRING     = 1, // rewrite big_string, then interpret it
+				STREAMED   = 2, // interpret symbols as the derivation is walked
+			};
+
+		// ---- streamed expansion (see vsl_lsystem_stream.hpp)
+			struct Stream
+			{
+				struct Frame
+				{
+					const CHAR *symbol;   // next symbol
+					const CHAR *end;      // end of axiom or rule
+					INT depth;            // generation of symbols
+				};
+				std::vector<Frame> frame;
+				const std::string **production;
+				INT depth;
+				VOID Start(const std::string *root, const std::string **production, INT depth);
+				CHAR Next();
+			};
+
+		// ---- turtle
+			struct Turtle
+			{
+				struct State
+				{
+					FLOAT position[4];             // x, y, z, 0
+					FLOAT direction[3][4];         // 3x3 rotation, rows x, y, z, 0
+				};
+				enum Rotation                      // precomputed rotation by symbol
+				{
+					Z_POSITIVE, Z_NEGATIVE,        // ^ v
+					Y_POSITIVE, Y_NEGATIVE,        // > <
+					X_POSITIVE, X_NEGATIVE,        // + -
+				};
+				__m128 position;                   // current state
+				__m128 direction[3];
+				__m128 rotation[6][3];             // 3x3 rotations by current_angle
+				std::vector<State> stack;          // flat "[" stack, grown as required
+				INT depth;                         // # of states on stack
+			};
+			VOID Lsystem_StartTurtle(Turtle *turtle, const Turtle::State *state);
+			VOID Lsystem_GetTurtleState(const Turtle *turtle, Turtle::State *state);
+			VOID Lsystem_Interpret(Turtle *turtle, CHAR c, LVertex **out);
+
+		// ---- parallel turtle (see vsl_lsystem_parallel.hpp)
+			enum { PARALLEL_MIN_LENGTH = 1 << 16 };
+			HRESULT Lsystem_DrawTreeParallel(LVertex *buffer);
+
+		// ---- indexed line list (see vsl_lsystem_indexed.hpp)
+			HRESULT Lsystem_DrawTreeIndexed();
+
 
 	private:
 
@@ -115,7 +187,8 @@ namespace vsl_application
 
 		// ---- font
 			LPD3DXFONT font;               // display text font
-			std::vector<LVertex> verts;    // list of vertices 
+			std::vector<LVertex> verts;    // list of vertices (pairs, or unique if indexed_on)
+			std::vector<UINT> indices;     // list of line indices, if indexed_on
 			LVertex v;                     // instance of vertex struct
 
 
@@ -130,6 +203,15 @@ namespace vsl_application
 			std::string rule_2;
 			std::string big_string;
 			std::string string_next;
+			const std::string *production[256]; // per symbol rule, NULL if none
+			std::vector<std::string> generation; // cache of axiom rewritten n times (see Lsystem_SetDepth)
+			std::string generation_key;         // axiom & rules of cache
+
+
+			// ---- lsystem expansion
+			ExpandMode expand_mode;       // string or streamed
+			INT   stream_depth;           // generations not applied to big_string, if streamed
+			INT   number_of_threads;      // turtle threads (<= 0 one per hardware thread, 1 serial)
 
 
 			// ---- display
@@ -137,6 +219,7 @@ namespace vsl_application
 			BOOL  text_on;                // toggle text
 			BOOL  turntable_on;           // toggle turntable
 			BOOL  fog_on;                 // toggle fog
+			BOOL  indexed_on;             // toggle indexed line list
 
 
 		// ---- process
@@ -0,0 +1,696 @@
+////////////////////////////////////////////////////////////////////////////////
+
+// ---------- vsl_lsystem_benchmark.hpp ----------
+/*!
+\file vsl_lsystem_benchmark.hpp
+\brief LSystem benchmark methods
+\author Gareth Edwards
+
+\note
+
+Benchmarks read the bundled "vsl_application/lsystem/data" files, so
+they replace the current L-system, and report via OutputDebugString.
+
+Lsystem_BenchmarkHeadless needs no device, & is run from the command
+line (see Lsystem_BenchmarkCommandLine), before any device is created:
+
+	vsl.exe -lsystem dragon.txt 20    file at depth (default file's)
+	vsl.exe -lsystem all              each bundled file, at its depth
+
+reporting to the console run from, & exiting with 0 if ok, else 1.
+
+A golden check is of the exact rewritten string (# of symbols & hash),
+the exact # of vertices, & their mean extent, to within 1 in 10^4, so
+it holds for any build of the turtle's FLOAT maths. The vertex hash is
+exact, so only comparable between runs of the same build & platform.
+
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---- bundled data files (as per keys 1 - 8)
+	static const CHAR *lsystem_data_files[] =
+	{
+		"newTree.txt",
+		"tA.txt",
+		"wikiTree.txt",
+		"tD.txt",
+		"tE.txt",
+		"tF.txt",
+		"koch2.txt",
+		"dragon.txt",
+	};
+
+
+// ---- golden output of each bundled data file, at its own depth
+	static struct Lsystem_Golden
+	{
+		const CHAR *filename;
+		INT    depth;
+		UINT64 symbols;
+		UINT64 string_hash;            // FNV-1a of big_string
+		UINT64 vertices;
+		DOUBLE mean_extent;            // mean |x| + |y| + |z| of vertices
+	} lsystem_golden[] =
+	{
+		{ "newTree.txt",   4,     11116, 0xc9f1eccefedc6c6dULL,     8192, 4.519824 },
+		{ "tA.txt",        5,      9373, 0x52de720a21ff1343ULL,     6250, 3.972921 },
+		{ "wikiTree.txt",  5,      7255, 0x5e9bddd3ed4df711ULL,     4960, 5.691211 },
+		{ "tD.txt",        6,      5699, 0x1c9dfb8da2e33d63ULL,     2660, 5.527813 },
+		{ "tE.txt",        7,     16269, 0x78fe462b9b2a1eeeULL,     4118, 6.937549 },
+		{ "tF.txt",        6,     25159, 0x7b0baba2743d9107ULL,    12096, 5.783639 },
+		{ "koch2.txt",     4,      2029, 0xf251aafdf3175c9dULL,     1250, 3.328200 },
+		{ "dragon.txt",    9,      1535, 0x5e9e1a444280e6d9ULL,      512, 2.321876 },
+	};
+
+
+// ---- FNV-1a 64 bit hash
+	static UINT64 Lsystem_Hash(const VOID *data, size_t bytes)
+	{
+		const BYTE *b = (const BYTE *)data;
+		UINT64 hash = 14695981039346656037ULL;
+		for ( size_t i = 0; i < bytes; i++ ) hash = ( hash ^ b[i] ) * 1099511628211ULL;
+		return hash;
+	}
+
+
+// ---------- Lsystem_BenchmarkIterate ----------
+/*!
+\brief time Lsystem_Iterate versus depth for each bundled data file
+\author Gareth Edwards
+\param INT max_depth [in] deepest generation
+\param INT max_length [in] stop deepening a file once its string is longer
+\return HRESULT (SUCCESS_OK if ok)
+*/
+HRESULT LSystem::Lsystem_BenchmarkIterate(
+		INT max_depth,
+		INT max_length
+	)
+{
+
+	// ---- local
+		using namespace std::chrono;
+		CHAR msg[256];
+
+	// ---- for each file
+		for ( const CHAR *filename : lsystem_data_files )
+		{
+
+			// ---- read
+				Lsystem_ReadTextfile(filename);
+				sprintf_s(msg, 256, "Lsystem_BenchmarkIterate: %s\n", filename);
+				OutputDebugString(msg);
+
+			// ---- for each depth, from the axiom
+				for ( INT depth = 1; depth <= max_depth; depth++ )
+				{
+					big_string = axiom;
+					auto start = high_resolution_clock::now();
+					Lsystem_Iterate(depth);
+					DOUBLE ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - start).count();
+					sprintf_s(msg, 256, "   depth %2d - %11zu symbols - %9.3f ms\n",
+							depth,
+							big_string.length(),
+							ms
+						);
+					OutputDebugString(msg);
+					if ( big_string.length() > (size_t)max_length ) break;
+				}
+
+		}
+
+	// ---- release
+		big_string.clear();
+		big_string.shrink_to_fit();
+		string_next.clear();
+		string_next.shrink_to_fit();
+
+	return SUCCESS_OK;
+}
+
+
+// ---------- Lsystem_BenchmarkStream ----------
+/*!
+\brief time & compare string & streamed expansion for each bundled data file
+\author Gareth Edwards
+\param INT extra_depth [in] generations beyond each file's depth
+\return HRESULT (SUCCESS_OK if ok, SUCCESS_FAULT if vertices differ)
+\note expansion memory is the string buffers, or the stream frames
+*/
+HRESULT LSystem::Lsystem_BenchmarkStream(
+		INT extra_depth
+	)
+{
+
+	// ---- local
+		using namespace std::chrono;
+		CHAR msg[256];
+		ExpandMode mode = expand_mode;
+		HRESULT hr = SUCCESS_OK;
+
+	// ---- for each file
+		for ( const CHAR *filename : lsystem_data_files )
+		{
+
+			// ---- read
+				Lsystem_ReadTextfile(filename);
+				INT depth = iteration_depth + extra_depth;
+				sprintf_s(msg, 256, "Lsystem_BenchmarkStream: %s depth %d\n", filename, depth);
+				OutputDebugString(msg);
+
+			// ---- string, then streamed
+				std::vector<LVertex> string_verts;
+				for ( ExpandMode m : { ExpandMode::STRING, ExpandMode::STREAMED } )
+				{
+					expand_mode = m;
+					big_string = axiom;
+					stream_depth = 0;
+					verts.clear();
+					auto start = high_resolution_clock::now();
+					Lsystem_Iterate(depth);
+					Lsystem_DrawTree();
+					DOUBLE ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - start).count();
+					size_t bytes = m == ExpandMode::STRING ?
+						big_string.capacity() + string_next.capacity() :
+						(depth + 1) * sizeof(Stream::Frame);
+					sprintf_s(msg, 256, "   %-8s - %10zu vertices - %9.3f ms - expansion %11zu bytes\n",
+							m == ExpandMode::STRING ? "string" : "streamed",
+							verts.size(),
+							ms,
+							bytes
+						);
+					OutputDebugString(msg);
+					if ( m == ExpandMode::STRING )
+					{
+						string_verts.swap(verts);
+						big_string.clear();
+						big_string.shrink_to_fit();
+						string_next.clear();
+						string_next.shrink_to_fit();
+					}
+				}
+
+			// ---- same ?
+				BOOL same = string_verts.size() == verts.size() &&
+					( verts.empty() || memcmp(&string_verts[0], &verts[0], verts.size() * sizeof(LVertex)) == 0 );
+				if ( !same )
+				{
+					OutputDebugString("   vertices differ!\n");
+					hr = SUCCESS_FAULT;
+				}
+
+		}
+
+	// ---- restore
+		expand_mode = mode;
+		verts.clear();
+		verts.shrink_to_fit();
+
+	return hr;
+}
+
+
+// ---------- Lsystem_BenchmarkDraw ----------
+/*!
+\brief time & compare serial & parallel Lsystem_DrawTree for each bundled data file
+\author Gareth Edwards
+\param INT extra_depth [in] generations beyond each file's depth
+\param INT max_threads [in] 1 to max_threads turtle threads
+\return HRESULT (SUCCESS_OK if ok, SUCCESS_FAULT if vertices differ)
+*/
+HRESULT LSystem::Lsystem_BenchmarkDraw(
+		INT extra_depth,
+		INT max_threads
+	)
+{
+
+	// ---- local
+		using namespace std::chrono;
+		CHAR msg[256];
+		ExpandMode mode = expand_mode;
+		INT threads = number_of_threads;
+		HRESULT hr = SUCCESS_OK;
+
+	// ---- for each file
+		expand_mode = ExpandMode::STRING;
+		for ( const CHAR *filename : lsystem_data_files )
+		{
+
+			// ---- read & iterate
+				Lsystem_ReadTextfile(filename);
+				INT depth = iteration_depth + extra_depth;
+				Lsystem_Iterate(depth);
+				sprintf_s(msg, 256, "Lsystem_BenchmarkDraw: %s depth %d - %zu symbols\n",
+						filename,
+						depth,
+						big_string.length()
+					);
+				OutputDebugString(msg);
+
+			// ---- for each # of threads
+				std::vector<LVertex> serial_verts;
+				DOUBLE serial_ms = 0;
+				for ( INT t = 1; t <= max_threads; t++ )
+				{
+					number_of_threads = t;
+					verts.clear();
+					auto start = high_resolution_clock::now();
+					Lsystem_DrawTree();
+					DOUBLE ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - start).count();
+					if ( t == 1 )
+					{
+						serial_ms = ms;
+						serial_verts.swap(verts);
+						sprintf_s(msg, 256, "   %2d thread  - %10zu vertices - %9.3f ms\n", t, serial_verts.size(), ms);
+					}
+					else
+					{
+						BOOL same = serial_verts.size() == verts.size() &&
+							( verts.empty() || memcmp(&serial_verts[0], &verts[0], verts.size() * sizeof(LVertex)) == 0 );
+						hr = same ? hr : SUCCESS_FAULT;
+						sprintf_s(msg, 256, "   %2d threads - %10zu vertices - %9.3f ms - x%.2f %s\n",
+								t,
+								verts.size(),
+								ms,
+								serial_ms / ms,
+								same ? "" : "(vertices differ!)"
+							);
+					}
+					OutputDebugString(msg);
+				}
+
+		}
+
+	// ---- restore
+		expand_mode = mode;
+		number_of_threads = threads;
+		verts.clear();
+		verts.shrink_to_fit();
+
+	return hr;
+}
+
+
+// ---------- Lsystem_BenchmarkTurtle ----------
+/*!
+\brief time serial Lsystem_DrawTree versus depth for dragon.txt & wikiTree.txt
+\author Gareth Edwards
+\param INT max_length [in] stop deepening a file once its string is longer
+\return HRESULT (SUCCESS_OK if ok)
+\note times only the turtle (Lsystem_Interpret), not Lsystem_Iterate
+*/
+HRESULT LSystem::Lsystem_BenchmarkTurtle(
+		INT max_length
+	)
+{
+
+	// ---- local
+		using namespace std::chrono;
+		CHAR msg[256];
+		ExpandMode mode = expand_mode;
+		INT threads = number_of_threads;
+
+	// ---- for each file
+		expand_mode = ExpandMode::STRING;
+		number_of_threads = 1;
+		for ( const CHAR *filename : { lsystem_data_files[7], lsystem_data_files[2] } )
+		{
+
+			// ---- read
+				Lsystem_ReadTextfile(filename);
+				sprintf_s(msg, 256, "Lsystem_BenchmarkTurtle: %s\n", filename);
+				OutputDebugString(msg);
+
+			// ---- for each depth, from the file's depth
+				for ( INT depth = iteration_depth; ; depth++ )
+				{
+					big_string = axiom;
+					Lsystem_Iterate(depth);
+					if ( big_string.length() > (size_t)max_length ) break;
+					verts.clear();
+					auto start = high_resolution_clock::now();
+					Lsystem_DrawTree();
+					DOUBLE ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - start).count();
+					sprintf_s(msg, 256, "   depth %2d - %11zu symbols - %10zu vertices - %9.3f ms - %6.2f ns per symbol\n",
+							depth,
+							big_string.length(),
+							verts.size(),
+							ms,
+							ms * 1000000 / (DOUBLE)big_string.length()
+						);
+					OutputDebugString(msg);
+				}
+
+		}
+
+	// ---- restore
+		expand_mode = mode;
+		number_of_threads = threads;
+		big_string.clear();
+		big_string.shrink_to_fit();
+		string_next.clear();
+		string_next.shrink_to_fit();
+		verts.clear();
+		verts.shrink_to_fit();
+
+	return SUCCESS_OK;
+}
+
+
+// ---------- Lsystem_BenchmarkHeadless ----------
+/*!
+\brief time, measure & check against golden output, Lsystem_Iterate & Lsystem_DrawTree
+\author Gareth Edwards
+\param const CHAR *filename [in] bundled data file
+\param INT depth [in] # of generations (<= 0 for the file's depth)
+\return HRESULT (SUCCESS_OK if ok, SUCCESS_FAULT if golden output differs)
+\note reports via OutputDebugString & stdout, & needs no device
+*/
+HRESULT LSystem::Lsystem_BenchmarkHeadless(
+		const CHAR *filename,
+		INT depth
+	)
+{
+
+	// ---- local
+		using namespace std::chrono;
+		CHAR msg[256];
+		ExpandMode mode = expand_mode;
+		HRESULT hr = SUCCESS_OK;
+		auto tell = [&msg]()
+		{
+			OutputDebugString(msg);
+			fputs(msg, stdout);
+		};
+		auto peak = []()
+		{
+			PROCESS_MEMORY_COUNTERS pmc;
+			GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc));
+			return (DOUBLE)pmc.PeakWorkingSetSize / (1024 * 1024);
+		};
+
+	// ---- read
+		auto start = high_resolution_clock::now();
+		Lsystem_ReadTextfile(filename);
+		DOUBLE ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - start).count();
+		depth = depth > 0 ? depth : iteration_depth;
+		sprintf_s(msg, 256, "Lsystem_BenchmarkHeadless: %s depth %d\n", filename, depth);
+		tell();
+		sprintf_s(msg, 256, "   read    - %11zu symbols  - %9.3f ms\n", big_string.length(), ms);
+		tell();
+
+	// ---- iterate
+		expand_mode = ExpandMode::STRING;
+		start = high_resolution_clock::now();
+		Lsystem_Iterate(depth);
+		ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - start).count();
+		sprintf_s(msg, 256, "   iterate - %11zu symbols  - %9.3f ms - %8.1f MB buffers - %8.1f MB peak\n",
+				big_string.length(),
+				ms,
+				(DOUBLE)(big_string.capacity() + string_next.capacity()) / (1024 * 1024),
+				peak()
+			);
+		tell();
+
+	// ---- draw
+		verts.clear();
+		start = high_resolution_clock::now();
+		Lsystem_DrawTree();
+		ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - start).count();
+		sprintf_s(msg, 256, "   draw    - %11zu vertices - %9.3f ms - %8.1f MB vertices - %8.1f MB peak\n",
+				verts.size(),
+				ms,
+				(DOUBLE)(verts.capacity() * sizeof(LVertex)) / (1024 * 1024),
+				peak()
+			);
+		tell();
+
+	// ---- hash & mean extent
+		UINT64 string_hash = Lsystem_Hash(big_string.data(), big_string.length());
+		UINT64 vertex_hash = verts.empty() ? 0 : Lsystem_Hash(&verts[0], verts.size() * sizeof(LVertex));
+		DOUBLE mean_extent = 0;
+		for ( LVertex &v : verts ) mean_extent += fabs(v.pos.x) + fabs(v.pos.y) + fabs(v.pos.z);
+		mean_extent = verts.empty() ? 0 : mean_extent / (DOUBLE)verts.size();
+		sprintf_s(msg, 256, "   hash    - string 0x%016llx - vertices 0x%016llx - mean extent %.6f\n",
+				string_hash,
+				vertex_hash,
+				mean_extent
+			);
+		tell();
+
+	// ---- golden ?
+		sprintf_s(msg, 256, "   golden  - none at this depth\n");
+		for ( Lsystem_Golden &g : lsystem_golden )
+		{
+			if ( strcmp(g.filename, filename) != 0 || g.depth != depth ) continue;
+			BOOL same =
+				g.symbols     == big_string.length() &&
+				g.string_hash == string_hash &&
+				g.vertices    == verts.size() &&
+				fabs(g.mean_extent - mean_extent) <= g.mean_extent * 1.0e-4;
+			hr = same ? SUCCESS_OK : SUCCESS_FAULT;
+			sprintf_s(msg, 256, "   golden  - %s\n", same ? "ok" : "FAILED");
+		}
+		tell();
+
+	// ---- restore & release
+		expand_mode = mode;
+		big_string.clear();
+		big_string.shrink_to_fit();
+		string_next.clear();
+		string_next.shrink_to_fit();
+		verts.clear();
+		verts.shrink_to_fit();
+
+	return hr;
+}
+
+
+// ---------- Lsystem_BenchmarkCommandLine ----------
+/*!
+\brief run Lsystem_BenchmarkHeadless, if "-lsystem <file | all> [depth]" is on the command line
+\author Gareth Edwards
+\param const CHAR *command_line [in] e.g. GetCommandLine()
+\param INT *exit_code [out] 0 if ok, 1 if golden output differs, 2 if usage
+\return HRESULT (SUCCESS_OK if run, SUCCESS_FAULT if no "-lsystem")
+\note the program path (quoted or not) is skipped, so a path that
+contains "-lsystem" does not run the benchmark
+*/
+HRESULT LSystem::Lsystem_BenchmarkCommandLine(
+		const CHAR *command_line,
+		INT *exit_code
+	)
+{
+
+	// ---- skip program path
+		const CHAR *args = command_line;
+		if ( *args == '"' )
+		{
+			args = strchr(args + 1, '"');
+			args = args == NULL ? "" : args + 1;
+		}
+		else
+		{
+			while ( *args != 0 && *args != ' ' && *args != '\t' ) args++;
+		}
+
+	// ---- "-lsystem" ?
+		const CHAR *option = strstr(args, "-lsystem");
+		if ( option == NULL ) return SUCCESS_FAULT;
+
+	// ---- report to the console run from, if any
+		if ( AttachConsole(ATTACH_PARENT_PROCESS) )
+		{
+			FILE *f;
+			freopen_s(&f, "CONOUT$", "w", stdout);
+		}
+
+	// ---- file & depth
+		CHAR filename[256] = { 0 };
+		INT depth = 0;
+		if ( sscanf_s(option + strlen("-lsystem"), "%255s %d", filename, 256, &depth) < 1 )
+		{
+			fputs("usage: -lsystem <file | all> [depth]\n", stdout);
+			*exit_code = 2;
+			return SUCCESS_OK;
+		}
+
+	// ---- run
+		HRESULT hr = SUCCESS_OK;
+		if ( strcmp(filename, "all") == 0 )
+		{
+			for ( const CHAR *f : lsystem_data_files )
+				hr = Lsystem_BenchmarkHeadless(f, 0) == SUCCESS_OK ? hr : SUCCESS_FAULT;
+		}
+		else
+		{
+			hr = Lsystem_BenchmarkHeadless(filename, depth);
+		}
+		fflush(stdout);
+		*exit_code = hr == SUCCESS_OK ? 0 : 1;
+
+	return SUCCESS_OK;
+}
+
+
+// ---------- Lsystem_BenchmarkIndexed ----------
+/*!
+\brief time & compare vertex pair & indexed line lists for each bundled data file
+\author Gareth Edwards
+\param INT extra_depth [in] generations beyond each file's depth
+\return HRESULT (SUCCESS_OK if ok, SUCCESS_FAULT if lines differ)
+\note lines are the same if each pair of indexed vertices is the same pair
+*/
+HRESULT LSystem::Lsystem_BenchmarkIndexed(
+		INT extra_depth
+	)
+{
+
+	// ---- local
+		using namespace std::chrono;
+		CHAR msg[256];
+		ExpandMode mode = expand_mode;
+		BOOL indexed = indexed_on;
+		HRESULT hr = SUCCESS_OK;
+
+	// ---- for each file
+		expand_mode = ExpandMode::STRING;
+		for ( const CHAR *filename : lsystem_data_files )
+		{
+
+			// ---- read & iterate
+				Lsystem_ReadTextfile(filename);
+				INT depth = iteration_depth + extra_depth;
+				Lsystem_Iterate(depth);
+				sprintf_s(msg, 256, "Lsystem_BenchmarkIndexed: %s depth %d\n", filename, depth);
+				OutputDebugString(msg);
+
+			// ---- pairs, then indexed
+				std::vector<LVertex> pair_verts;
+				for ( BOOL on : { FALSE, TRUE } )
+				{
+					indexed_on = on;
+					verts.clear();
+					indices.clear();
+					auto start = high_resolution_clock::now();
+					Lsystem_DrawTree();
+					DOUBLE ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - start).count();
+					size_t bytes = verts.size() * sizeof(LVertex) + ( on ? indices.size() * sizeof(UINT) : 0 );
+					sprintf_s(msg, 256, "   %-7s - %10zu vertices - %10zu indices - %8.2f MB - %9.3f ms\n",
+							on ? "indexed" : "pairs",
+							verts.size(),
+							on ? indices.size() : 0,
+							(DOUBLE)bytes / (1024 * 1024),
+							ms
+						);
+					OutputDebugString(msg);
+					if ( !on ) pair_verts.swap(verts);
+				}
+
+			// ---- same lines ?
+				BOOL same = pair_verts.size() == indices.size();
+				for ( size_t i = 0; same && i < indices.size(); i++ )
+					same = memcmp(&pair_verts[i], &verts[indices[i]], sizeof(LVertex)) == 0;
+				if ( !same )
+				{
+					OutputDebugString("   lines differ!\n");
+					hr = SUCCESS_FAULT;
+				}
+
+		}
+
+	// ---- restore
+		expand_mode = mode;
+		indexed_on = indexed;
+		verts.clear();
+		verts.shrink_to_fit();
+		indices.clear();
+		indices.shrink_to_fit();
+
+	return hr;
+}
+
+
+// ---------- Lsystem_BenchmarkDepth ----------
+/*!
+\brief time & compare Lsystem_Iterate from the axiom with cached Lsystem_SetDepth steps
+\author Gareth Edwards
+\param INT extra_depth [in] generations beyond each file's depth
+\return HRESULT (SUCCESS_OK if ok, SUCCESS_FAULT if strings differ)
+\note steps are up from the file's depth, then back down, as per the arrow keys
+*/
+HRESULT LSystem::Lsystem_BenchmarkDepth(
+		INT extra_depth
+	)
+{
+
+	// ---- local
+		using namespace std::chrono;
+		CHAR msg[256];
+		ExpandMode mode = expand_mode;
+		HRESULT hr = SUCCESS_OK;
+
+	// ---- for each file
+		expand_mode = ExpandMode::STRING;
+		for ( const CHAR *filename : lsystem_data_files )
+		{
+
+			// ---- read, & cache to file's depth
+				Lsystem_ReadTextfile(filename);
+				INT first = iteration_depth;
+				INT last  = iteration_depth + extra_depth;
+				generation.clear();
+				Lsystem_SetDepth(first);
+				sprintf_s(msg, 256, "Lsystem_BenchmarkDepth: %s depth %d - %d\n", filename, first, last);
+				OutputDebugString(msg);
+
+			// ---- for each depth, up then down
+				for ( INT step = 1; step <= 2 * extra_depth; step++ )
+				{
+
+					// ---- from the axiom
+						INT depth = step <= extra_depth ? first + step : last - ( step - extra_depth );
+						big_string = axiom;
+						auto start = high_resolution_clock::now();
+						Lsystem_Iterate(depth);
+						DOUBLE iterate_ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - start).count();
+						std::string iterated;
+						iterated.swap(big_string);
+
+					// ---- cached
+						start = high_resolution_clock::now();
+						Lsystem_SetDepth(depth);
+						DOUBLE cached_ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - start).count();
+						BOOL same = iterated == big_string;
+						hr = same ? hr : SUCCESS_FAULT;
+
+					// ---- tell
+						size_t bytes = 0;
+						for ( std::string &g : generation ) bytes += g.capacity();
+						sprintf_s(msg, 256, "   %s depth %2d - %11zu symbols - iterate %9.3f ms - cached %9.3f ms - cache %8.1f MB %s\n",
+								step <= extra_depth ? "up  " : "down",
+								depth,
+								big_string.length(),
+								iterate_ms,
+								cached_ms,
+								(DOUBLE)bytes / (1024 * 1024),
+								same ? "" : "(strings differ!)"
+							);
+						OutputDebugString(msg);
+
+				}
+
+		}
+
+	// ---- restore & release
+		expand_mode = mode;
+		generation.clear();
+		generation.shrink_to_fit();
+		big_string.clear();
+		big_string.shrink_to_fit();
+		string_next.clear();
+		string_next.shrink_to_fit();
+
+	return hr;
+}
@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////
+
+// ---------- vsl_lsystem_indexed.hpp ----------
+/*!
+\file vsl_lsystem_indexed.hpp
+\brief LSystem indexed line list methods
+\author Gareth Edwards
+
+\note
+
+Lsystem_DrawTree adds a pair of vertices per 'F', so the end of each
+line is added again as the start of the next. If indexed_on, then
+Lsystem_DrawTreeIndexed instead adds each vertex once, & a pair of
+32 bit indices per 'F', by noting the vertex (if any) at the turtle's
+position:
+
+	F:           if none, add a vertex at the position, then move, add
+	             a vertex at the new position, & index both
+
+	[ & ]:       push & pop the noted vertex, with the turtle's state,
+	             so a branch shares the vertex it starts from
+
+	^ v > < + -: position is unchanged, so nor is the noted vertex
+
+So a run of n 'F' has n + 1 vertices, rather than 2n, & is drawn with
+DrawIndexedPrimitiveUP (D3DPT_LINELIST, D3DFMT_INDEX32).
+
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- Lsystem_DrawTreeIndexed ----------
+/*!
+\brief generate unique vertices & a line list of indices based on L-system symbols
+\author Gareth Edwards
+\return HRESULT (SUCCESS_OK if ok, SUCCESS_FAULT if too many vertices for 32 bit indices)
+\note vertices are added to verts, & indices replace indices
+*/
+HRESULT LSystem::Lsystem_DrawTreeIndexed()
+{
+
+	// ---- size, at most a pair of vertices, & exactly a pair of indices, per 'F'
+		UINT64 number_of_pairs = Lsystem_GetVertexCount();
+		size_t first = verts.size();
+		if ( first + number_of_pairs > 0xFFFFFFFF ) return SUCCESS_FAULT;
+		verts.resize(first + (size_t)number_of_pairs);
+		indices.resize((size_t)number_of_pairs);
+
+
+	// ---- local
+		LVertex *vertex = verts.data() + first;
+		UINT    *index  = indices.data();
+		UINT     next   = (UINT)first;             // index of next vertex
+		const UINT NONE = 0xFFFFFFFF;
+		UINT     at     = NONE;                    // index of vertex at turtle's position
+		std::vector<UINT> at_stack;
+		Turtle turtle;
+		Lsystem_StartTurtle(&turtle, NULL);
+
+
+	// ---- add a vertex at the turtle's position
+		auto add = [&]()
+		{
+			FLOAT p[4];
+			_mm_storeu_ps(p, turtle.position);
+			vertex++->pos = D3DXVECTOR3(p[0], p[1], p[2]);
+			at = next++;
+		};
+
+
+	// ---- interpret one symbol
+		auto interpret = [&](CHAR c)
+		{
+			switch ( c )
+			{
+				case 'F' :
+					if ( at == NONE ) add();
+					*index++ = at;
+					Lsystem_Interpret(&turtle, c, NULL);
+					add();
+					*index++ = at;
+					break;
+
+				case '[' :
+					at_stack.push_back(at);
+					Lsystem_Interpret(&turtle, c, NULL);
+					break;
+
+				case ']' :
+					if ( !at_stack.empty() )           // as per Lsystem_Interpret, ignore if unbalanced
+					{
+						at = at_stack.back();
+						at_stack.pop_back();
+					}
+					Lsystem_Interpret(&turtle, c, NULL);
+					break;
+
+				default :
+					Lsystem_Interpret(&turtle, c, NULL);
+					break;
+			}
+		};
+
+
+	// ---- iterate through string, or streamed expansion
+		if ( expand_mode == ExpandMode::STREAMED )
+		{
+			Stream stream;
+			stream.Start(&big_string, production, stream_depth);
+			for (CHAR c = stream.Next(); c != 0; c = stream.Next())
+				interpret(c);
+		}
+		else
+		{
+			for (INT i = 0; i < (INT)big_string.length(); i++)
+				interpret(big_string[i]);
+		}
+
+
+	// ---- trim to vertices added
+		verts.resize(next);
+
+	return SUCCESS_OK;
+}
@@ -0,0 +1,202 @@
+////////////////////////////////////////////////////////////////////////////////
+
+// ---------- vsl_lsystem_parallel.hpp ----------
+/*!
+\file vsl_lsystem_parallel.hpp
+\brief LSystem parallel turtle interpretation methods
+\author Gareth Edwards
+
+\note
+
+A "[ ... ]" branch restores the turtle's position & direction, so once
+its starting state is known it can be interpreted independently of the
+rest of the string. Lsystem_DrawTreeParallel:
+
+	1. matches brackets, & keeps each branch longer than a grain size
+	   (about 1/16th of a thread's share of the string) as a task, the
+	   whole string being the root task, & each task's parent being the
+	   smallest task enclosing it
+
+	2. finds each task's starting state, in string order, by moving a
+	   turtle through the symbols of its parent that are not in a branch
+	   (which are skipped, as they leave the state unchanged)
+
+	3. interprets the tasks, largest first, on worker threads, skipping
+	   its child tasks
+
+Each 'F' adds 2 vertices, in string order, so the vertices of the 'F'
+preceded by f others are at 2 * f. So, with the # of 'F' before each
+task & in each child noted in step 1, each task writes its vertices
+directly to their place in the buffer, skipping those of its children.
+
+As every symbol is interpreted by Lsystem_Interpret, from the same
+state, the vertices are identical to those of the serial path.
+
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- Lsystem_DrawTreeParallel ----------
+/*!
+\brief generate vertices based on L-system symbols, concurrently
+\author Gareth Edwards
+\param LVertex * (buffer) room for Lsystem_GetVertexCount vertices
+\return HRESULT (SUCCESS_OK if ok, else SUCCESS_FAULT & nothing is written,
+	e.g. if brackets are unbalanced, or only one thread)
+*/
+HRESULT LSystem::Lsystem_DrawTreeParallel(
+		LVertex *buffer
+	)
+{
+
+	// ---- local
+		const CHAR *s = big_string.data();
+		INT n = (INT)big_string.length();
+
+	// ---- threads
+		INT threads = number_of_threads;
+		if ( threads <= 0 )
+		{
+			threads = (INT)std::thread::hardware_concurrency();
+			threads = threads < 1 ? 1 : threads;
+		}
+		if ( threads == 1 ) return SUCCESS_FAULT;
+
+	// ---- task
+		struct Task
+		{
+			INT begin, end;                // [begin, end) of string
+			INT64 f_begin, f_end;          // # of 'F' before begin & end
+			Turtle::State start;           // starting state
+			std::vector<INT> child;        // in string order
+		};
+		std::vector<Task> task(1);
+		task[0].begin = 0;
+		task[0].end = n;
+		task[0].f_begin = 0;
+		Turtle turtle;
+		Lsystem_StartTurtle(&turtle, NULL);
+		Lsystem_GetTurtleState(&turtle, &task[0].start);
+
+
+	// ---- 1. match brackets, keeping long branches as tasks
+		INT grain = n / (threads * 16);
+		grain = grain < 4096 ? 4096 : grain;
+		std::vector<std::pair<INT, INT64>> open;   // index & # of 'F' before
+		INT64 f = 0;
+		for ( INT i = 0; i < n; i++ )
+		{
+			if ( s[i] == 'F' )
+			{
+				f++;
+			}
+			else if ( s[i] == '[' )
+			{
+				open.push_back(std::make_pair(i, f));
+			}
+			else if ( s[i] == ']' )
+			{
+				if ( open.empty() ) return SUCCESS_FAULT;
+				INT o = open.back().first;
+				if ( i - o > grain )
+				{
+					Task t;
+					t.begin = o;
+					t.end = i + 1;
+					t.f_begin = open.back().second;
+					t.f_end = f;
+					task.push_back(t);
+				}
+				open.pop_back();
+			}
+		}
+		task[0].f_end = f;
+		if ( !open.empty() ) return SUCCESS_FAULT;
+		if ( task.size() == 1 ) return SUCCESS_FAULT;
+
+	// ---- in string order, so parents are before their children
+		std::sort(task.begin() + 1, task.end(),
+				[](const Task &a, const Task &b) { return a.begin < b.begin; }
+			);
+		std::vector<INT> enclosing(1, 0);
+		for ( INT t = 1; t < (INT)task.size(); t++ )
+		{
+			while ( task[enclosing.back()].end <= task[t].begin ) enclosing.pop_back();
+			task[enclosing.back()].child.push_back(t);
+			enclosing.push_back(t);
+		}
+
+
+	// ---- 2. starting states, moving a turtle through each parent
+		for ( INT t = 0; t < (INT)task.size(); t++ )
+		{
+			Task *p = &task[t];
+			if ( p->child.empty() ) continue;
+			Lsystem_StartTurtle(&turtle, &p->start);
+			INT k = 0;
+			INT begin = t == 0 ? p->begin : p->begin + 1;   // inside own brackets
+			INT end   = t == 0 ? p->end   : p->end - 1;
+			for ( INT i = begin; i < end; i++ )
+			{
+				if ( k < (INT)p->child.size() && i == task[p->child[k]].begin )
+				{
+					Task *c = &task[p->child[k++]];
+					Lsystem_GetTurtleState(&turtle, &c->start);
+					i = c->end - 1;
+				}
+				else if ( s[i] == '[' )
+				{
+					for ( INT depth = 0; ; i++ )
+					{
+						depth += s[i] == '[' ? 1 : s[i] == ']' ? -1 : 0;
+						if ( depth == 0 ) break;
+					}
+				}
+				else
+				{
+					Lsystem_Interpret(&turtle, s[i], NULL);
+				}
+			}
+		}
+
+
+	// ---- 3. interpret tasks, largest first, into place
+		std::vector<INT> order(task.size());
+		for ( INT t = 0; t < (INT)task.size(); t++ ) order[t] = t;
+		std::sort(order.begin(), order.end(),
+				[&](INT a, INT b) { return task[a].end - task[a].begin > task[b].end - task[b].begin; }
+			);
+		volatile LONG next = -1;
+		auto worker = [&]()
+		{
+			Turtle turtle;
+			for ( LONG o = InterlockedIncrement(&next); o < (LONG)order.size(); o = InterlockedIncrement(&next) )
+			{
+				Task *p = &task[order[o]];
+				Lsystem_StartTurtle(&turtle, &p->start);
+				LVertex *out = buffer + 2 * p->f_begin;
+				INT k = 0;
+				for ( INT i = p->begin; i < p->end; i++ )
+				{
+					if ( k < (INT)p->child.size() && i == task[p->child[k]].begin )
+					{
+						Task *c = &task[p->child[k++]];
+						out += 2 * ( c->f_end - c->f_begin );
+						i = c->end - 1;
+					}
+					else
+					{
+						Lsystem_Interpret(&turtle, s[i], &out);
+					}
+				}
+			}
+		};
+		INT number_of_workers = threads < (INT)task.size() ? threads : (INT)task.size();
+		std::vector<std::thread> thread;
+		for ( INT w = 1; w < number_of_workers; w++ ) thread.push_back(std::thread(worker));
+		worker();
+		for ( std::thread &t : thread ) t.join();
+
+	return SUCCESS_OK;
+}
@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+
+// ---------- vsl_lsystem_stream.hpp ----------
+/*!
+\file vsl_lsystem_stream.hpp
+\brief LSystem streamed expansion methods
+\author Gareth Edwards
+
+\note
+
+In STREAMED expand mode Lsystem_Iterate does not rewrite big_string,
+it only counts the generations still to be applied to it. Then
+Lsystem_DrawTree walks the derivation tree depth first, from big_string,
+with an explicit stack of frames, each holding the next symbol in the
+axiom or a rule and the generation of that symbol:
+
+	1. take the next symbol of the top frame (pop the frame if none)
+
+	2. if it has a rule & is not yet of the last generation, push a
+	   frame for the rule, one generation on
+
+	3. otherwise yield it to the turtle interpreter
+
+So symbols are yielded in the same order as they would be in the
+rewritten string, but memory is O(depth) frames (each pointing into
+the axiom or a rule), instead of O(length of the rewritten string).
+
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- Stream::Start ----------
+/*!
+\brief start a streamed expansion
+\author Gareth Edwards
+\param const std::string *root [in] string of generation 0 (e.g. the axiom)
+\param const std::string **production [in] 256 per symbol rules, NULL if none
+\param INT depth [in] # of generations to apply to root
+\note root & rules must not change until Next returns 0
+*/
+VOID LSystem::Stream::Start(
+		const std::string *root,
+		const std::string **production,
+		INT depth
+	)
+{
+	this->production = production;
+	this->depth = depth;
+	frame.clear();
+	frame.reserve(depth + 1);
+	frame.push_back({ root->data(), root->data() + root->length(), 0 });
+}
+
+
+// ---------- Stream::Next ----------
+/*!
+\brief get the next symbol of the expansion
+\author Gareth Edwards
+\return CHAR next symbol (0 if none)
+*/
+CHAR LSystem::Stream::Next()
+{
+
+	// ---- until a symbol is yielded, or stack is empty
+		while ( !frame.empty() )
+		{
+
+			// ---- end of axiom or rule ?
+				Frame *top = &frame.back();
+				if ( top->symbol == top->end )
+				{
+					frame.pop_back();
+					continue;
+				}
+
+			// ---- rewrite ?
+				CHAR c = *top->symbol++;
+				const std::string *p = production[(BYTE)c];
+				if ( p != NULL && top->depth < depth )
+				{
+					frame.push_back({ p->data(), p->data() + p->length(), top->depth + 1 });
+					continue;
+				}
+
+			return c;
+		}
+
+	return 0;
+}
@@ -11,6 +11,12 @@
 // ----- include eLsystem header -----
 	#include "../header/vsl_lsystem.h"
 
+// ---- std
+	#include <algorithm> // count & sort (see parallel hpp)
+
+// ---- system
+	#include <psapi.h>   // GetProcessMemoryInfo (see benchmark hpp)
+
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -33,11 +39,23 @@ LSystem::LSystem()
 		fw_win_create.SetName("VS Lite L System Demo");
 		fw_win_create.SetDesktop(TRUE);
 
+	// ---- production table: one lookup per symbol, NULL if unchanged
+		for (INT i = 0; i < 256; i++) production[i] = NULL;
+		production['F'] = &rule;         // replace 'F' with rule
+		production['X'] = &rule_1;       // replace 'X' with rule_1
+		production['Y'] = &rule_2;       // replace 'Y' with rule_2
+
+	// ---- expansion
+		expand_mode  = ExpandMode::STRING;
+		stream_depth = 0;
+		number_of_threads = 0;
+
 	// ---- display
 		instructions_on = true;
 		text_on         = true;
 		turntable_on    = true;
 		fog_on          = true;
+		indexed_on      = false;
 
 	// ---- set default display values
 		Display_SetDefaults();
@@ -74,7 +92,12 @@ LSystem::~LSystem()
 */
 HRESULT LSystem::Fw_Setup()
 {
-	
+
+	// ---- headless benchmark ? - run, then exit (see vsl_lsystem_benchmark.hpp)
+		INT exit_code = 0;
+		if ( Lsystem_BenchmarkCommandLine(GetCommandLine(), &exit_code) == SUCCESS_OK )
+			exit(exit_code);
+
 	// ---- init props
 		camera_y_offset    = -3;
 		variable_selected  = 1;
@@ -125,6 +148,42 @@ HRESULT LSystem::Fw_SetupDX(LPDIRECT3DDEVICE9 p_d3d_device)
 				&font
 			);
 
+	// ---- ? rewriting benchmark (every data file, to depth 24 or 64M symbols)
+		if (FALSE)
+		{
+			Lsystem_BenchmarkIterate(24, 1 << 26);
+		}
+
+	// ---- ? streamed expansion benchmark (every data file, to default depth + 2)
+		if (FALSE)
+		{
+			Lsystem_BenchmarkStream(2);
+		}
+
+	// ---- ? parallel turtle benchmark (every data file, to default depth + 2, 1 - 8 threads)
+		if (FALSE)
+		{
+			Lsystem_BenchmarkDraw(2, 8);
+		}
+
+	// ---- ? serial turtle benchmark (dragon.txt & wikiTree.txt, to 32M symbols)
+		if (FALSE)
+		{
+			Lsystem_BenchmarkTurtle(1 << 25);
+		}
+
+	// ---- ? indexed line list benchmark (every data file, to default depth + 2)
+		if (FALSE)
+		{
+			Lsystem_BenchmarkIndexed(2);
+		}
+
+	// ---- ? cached depth benchmark (every data file, to default depth + 4)
+		if (FALSE)
+		{
+			Lsystem_BenchmarkDepth(4);
+		}
+
 	// ---- start up with...
 		Lsystem_ReadTextfile("tF.txt");
 		Tree   = "F";             // display name
@@ -132,7 +191,7 @@ HRESULT LSystem::Fw_SetupDX(LPDIRECT3DDEVICE9 p_d3d_device)
 
 
 	// ---- iterate through the text file
-		Lsystem_Iterate(iteration_depth);
+		Lsystem_SetDepth(iteration_depth);
 
 	// ---- draw instructions
 		Lsystem_DrawTree();
@@ -201,8 +260,16 @@ HRESULT LSystem::Fw_Display (LPDIRECT3DDEVICE9 p_d3d_device)
 		p_d3d_device->SetFVF(LVertex::FVF_Flags );
 
 
-	// ---- pass list of vertices to LINELIST
-		p_d3d_device->DrawPrimitiveUP( D3DPT_LINELIST, (INT)(verts.size() * 0.5f), &verts[0], sizeof(LVertex));
+	// ---- pass list of vertices to LINELIST, indexed or as pairs
+		if ( indexed_on && !indices.empty() )
+		{
+			p_d3d_device->DrawIndexedPrimitiveUP(D3DPT_LINELIST, 0, (UINT)verts.size(), (UINT)indices.size() / 2,
+				&indices[0], D3DFMT_INDEX32, &verts[0], sizeof(LVertex));
+		}
+		else
+		{
+			p_d3d_device->DrawPrimitiveUP( D3DPT_LINELIST, (INT)(verts.size() * 0.5f), &verts[0], sizeof(LVertex));
+		}
 
 
 	// ---- toggle text
@@ -353,6 +420,23 @@ VOID LSystem::Fw_Set_Keydown(WPARAM param)
 				}
 				break;
 
+		    case 'S':    // toggles streamed expansion, & re-iterate rule(s)
+				{
+					expand_mode = expand_mode == ExpandMode::STREAMED ?
+						ExpandMode::STRING : ExpandMode::STREAMED;
+					Lsystem_SetDepth(iteration_depth);
+					verts.clear();
+				}
+				break;
+
+		    case 'I':    // toggles indexed line list
+				{
+					indexed_on = indexed_on ? FALSE : TRUE;
+					verts.clear();
+					indices.clear();
+				}
+				break;
+
 		    case 'V':    // toggles lsystem info & variables
 				{
 					instructions_on = instructions_on ? FALSE : TRUE;
@@ -369,7 +453,7 @@ VOID LSystem::Fw_Set_Keydown(WPARAM param)
 					Tree = "MkII Fern";            // display name
 					rule_1 = "n/a";                // display n/a if no rule present
 					rule_2 = "n/a";
-					Lsystem_Iterate(iteration_depth);      // re-iterate rule(s)
+					Lsystem_SetDepth(iteration_depth);     // re-iterate rule(s)
 					verts.clear();                 // clear vertex list
 			        camera_y_offset = -3;          // adjust camera Y-axis
 				}
@@ -381,7 +465,7 @@ VOID LSystem::Fw_Set_Keydown(WPARAM param)
 					Tree = "A";
 					rule_1 = "n/a";
 					rule_2 = "n/a";
-					Lsystem_Iterate(iteration_depth);
+					Lsystem_SetDepth(iteration_depth);
 					verts.clear();   
 			        camera_y_offset = -3;
 				}
@@ -392,7 +476,7 @@ VOID LSystem::Fw_Set_Keydown(WPARAM param)
 					Lsystem_ReadTextfile("wikiTree.txt");
 					Tree = "wikiTree";
 					rule_2 = "n/a";
-					Lsystem_Iterate(iteration_depth);
+					Lsystem_SetDepth(iteration_depth);
 					verts.clear();
 			        camera_y_offset = -3;
 				}
@@ -404,7 +488,7 @@ VOID LSystem::Fw_Set_Keydown(WPARAM param)
 					Lsystem_ReadTextfile("tD.txt");
 					Tree = "D";
 					rule_2 = "n/a";
-					Lsystem_Iterate(iteration_depth);
+					Lsystem_SetDepth(iteration_depth);
 					verts.clear();	
 			        camera_y_offset = -3;
 				}
@@ -415,7 +499,7 @@ VOID LSystem::Fw_Set_Keydown(WPARAM param)
 					Lsystem_ReadTextfile("tE.txt");
 					Tree = "E";
 					rule_2 = "n/a";
-					Lsystem_Iterate(iteration_depth);
+					Lsystem_SetDepth(iteration_depth);
 					verts.clear();
 			        camera_y_offset = -3;
 				}
@@ -426,7 +510,7 @@ VOID LSystem::Fw_Set_Keydown(WPARAM param)
 					Lsystem_ReadTextfile("tF.txt");
 					Tree = "F";
 					rule_2 = "n/a";
-					Lsystem_Iterate(iteration_depth);
+					Lsystem_SetDepth(iteration_depth);
 					verts.clear();
 			        camera_y_offset = -3;
 				}
@@ -438,7 +522,7 @@ VOID LSystem::Fw_Set_Keydown(WPARAM param)
 					Tree = "Koch-based 3D structure";
 					rule_1 = "n/a";
 					rule_2 = "n/a";
-					Lsystem_Iterate(iteration_depth);
+					Lsystem_SetDepth(iteration_depth);
 					verts.clear();
 			        camera_y_offset = -1;
 				}
@@ -449,7 +533,7 @@ VOID LSystem::Fw_Set_Keydown(WPARAM param)
 					Lsystem_ReadTextfile("dragon.txt");
 					Tree = "Dragon 2D";
 					rule = "n/a";
-					Lsystem_Iterate(iteration_depth);
+					Lsystem_SetDepth(iteration_depth);
 					verts.clear();
 			        camera_y_offset = -1;
 					break;
@@ -520,9 +604,9 @@ VOID LSystem::Fw_Set_Keydown(WPARAM param)
 /*!
 \brief read a text file and seperate into component strings
 \author Gareth Edwards
-\param  CHAR * (fileName)
+\param  const CHAR * (fileName)
 */
-VOID LSystem::Lsystem_ReadTextfile(CHAR *filename)
+VOID LSystem::Lsystem_ReadTextfile(const CHAR *filename)
 {
 
 	// ---- create ifstream object
@@ -557,6 +641,7 @@ VOID LSystem::Lsystem_ReadTextfile(CHAR *filename)
 
 	// ---- set big_string to inital axiom before iteration
 		big_string = axiom;    
+		stream_depth = 0;
 
 }
 
@@ -566,46 +651,25 @@ VOID LSystem::Lsystem_ReadTextfile(CHAR *filename)
 \brief iterate through the main L-system string
 \author Gareth Edwards
 \param  int (counter)
+\note each generation is rewritten into string_next, which is then
+swapped with big_string (so both buffers are reused)
+\note if streamed, only counts generations (see vsl_lsystem_stream.hpp)
 */
 VOID LSystem::Lsystem_Iterate(INT counter)
 {
 
-	// ---- 1st loop sets no. of times to loop through string
-		for (INT i = 0; i < counter; i++)
+	// ---- streamed ? - defer generations to Lsystem_DrawTree
+		if ( expand_mode == ExpandMode::STREAMED )
 		{
+			stream_depth += counter;
+			return;
+		}
 
-			// ---- empty string to copy into
-				std::string string_next = "";
-      
-			// ---- 2nd loop iterates through main string 
-				for (INT j = 0; j < (INT)big_string.length(); j++)
-				{
-					CHAR c = big_string.at(j);               // current CHAR in string   
-
-					if ( c == 'F' )
-					{
-						string_next = string_next + rule;    // replace 'F' with rule 
-					}
-					else if ( c == 'X' )
-					{
-						string_next = string_next + rule_1;  // replace 'X' with rule_1
-					}
-					else if ( c == 'Y' )
-					{
-						string_next = string_next + rule_2;  // replace 'Y' with rule_2
-					}
-					else
-					{
-						string_next = string_next + c;       // otherwise insert current CHAR
-					} 
-  
-				}
-
-			// ---- copy into main string
-				big_string = string_next;
-
-			// ---- until 1st loop condition is met
-
+	// ---- rewrite string counter times
+		for (INT i = 0; i < counter; i++)
+		{
+			Lsystem_Rewrite(big_string, &string_next);
+			big_string.swap(string_next);
 		}
 
 
@@ -621,132 +685,433 @@ VOID LSystem::Lsystem_Iterate(INT counter)
 }  
 
 
+// ---------- Lsystem_Rewrite ----------
+/*!
+\brief rewrite one generation of an L-system string
+\author Gareth Edwards
+\param const std::string & (from) generation n
+\param std::string * (to) [out] generation n + 1
+\note the next generation is sized exactly from a count of its symbols,
+reserved once, & built with bulk appends of rules & runs of unchanged
+symbols
+*/
+VOID LSystem::Lsystem_Rewrite(
+		const std::string &from,
+		std::string *to
+	)
+{
+
+	// ---- exact length of next generation
+		size_t count[256] = { 0 };
+		for (CHAR c : from) count[(BYTE)c]++;
+		size_t length = 0;
+		for (INT k = 0; k < 256; k++)
+			length += count[k] * ( production[k] == NULL ? 1 : production[k]->length() );
+
+	// ---- reserve once
+		to->clear();
+		to->reserve(length);
+
+	// ---- append rules & runs of unchanged symbols
+		const CHAR *s = from.data();
+		size_t n = from.length();
+		size_t j = 0;
+		while (j < n)
+		{
+			const std::string *p = production[(BYTE)s[j]];
+			if ( p != NULL )
+			{
+				to->append(*p);
+				j++;
+			}
+			else
+			{
+				size_t k = j + 1;
+				while (k < n && production[(BYTE)s[k]] == NULL) k++;
+				to->append(s + j, k - j);
+				j = k;
+			}
+		}
+
+}
+
+
+// ---------- Lsystem_SetDepth ----------
+/*!
+\brief set big_string to a generation of the axiom, rewriting only generations not yet cached
+\author Gareth Edwards
+\param INT (depth) # of generations (< 0 as 0)
+\note generation[n] caches each string rewritten from the axiom, so
+stepping depth down is a copy, & up by one is one rewrite; the cache is
+rebuilt if the axiom or a rule has changed (e.g. a file is read)
+\note if streamed, nothing is cached, as big_string is the axiom
+*/
+VOID LSystem::Lsystem_SetDepth(INT depth)
+{
+
+	// ---- streamed ? - defer generations to Lsystem_DrawTree
+		depth = depth < 0 ? 0 : depth;
+		if ( expand_mode == ExpandMode::STREAMED )
+		{
+			big_string = axiom;
+			stream_depth = depth;
+			return;
+		}
+
+	// ---- axiom or a rule changed ? - restart cache
+		std::string key = axiom + '\n' + rule + '\n' + rule_1 + '\n' + rule_2;
+		if ( key != generation_key || generation.empty() )
+		{
+			generation_key = key;
+			generation.assign(1, axiom);
+		}
+
+	// ---- rewrite generations not cached
+		while ( (INT)generation.size() <= depth )
+		{
+			generation.resize(generation.size() + 1);
+			Lsystem_Rewrite(generation[generation.size() - 2], &generation.back());
+		}
+
+	// ---- copy
+		big_string = generation[depth];
+		stream_depth = 0;
+
+}
+
+
 // ---------- Lsystem_DrawTree ---------
 /*!
 \brief generate a list of vectors based on L-system symbols
 \author Gareth Edwards
+\note verts is sized exactly, by Lsystem_GetVertexCount, then written
+by Lsystem_DrawTreeToBuffer
+\note if indexed_on, see Lsystem_DrawTreeIndexed
 */
 VOID LSystem::Lsystem_DrawTree()
 {        
+	if ( indexed_on )
+	{
+		Lsystem_DrawTreeIndexed();
+		return;
+	}
+	UINT64 number_of_vertices = Lsystem_GetVertexCount();
+	size_t first = verts.size();
+	verts.resize(first + (size_t)number_of_vertices);
+	Lsystem_DrawTreeToBuffer(verts.data() + first, number_of_vertices);
+}
+
+
+// ---------- Lsystem_GetVertexCount ---------
+/*!
+\brief get # of vertices Lsystem_DrawTree will generate, without interpreting
+\author Gareth Edwards
+\return UINT64 # of vertices (2 per 'F')
+\note if streamed, big_string's symbol counts are multiplied by the
+production count matrix to the power of stream_depth, where row a is
+the count of each symbol in a's rule (or just a, if a has no rule)
+*/
+UINT64 LSystem::Lsystem_GetVertexCount()
+{
 
-	// ---- local rotation matrices for each axis
-		D3DXMATRIX zRotation;
-		D3DXMATRIX yRotation;
-		D3DXMATRIX xRotation;
+	// ---- fully rewritten ?
+		INT generations = expand_mode == ExpandMode::STREAMED ? stream_depth : 0;
+		if ( generations == 0 ) return 2 * (UINT64)std::count(big_string.begin(), big_string.end(), 'F');
 
 
-	// ---- local stack for last position vector
-		std::stack<D3DXVECTOR3> position_stack;
+	// ---- symbol counts of big_string
+		UINT64 histogram[256] = { 0 };
+		for (CHAR c : big_string) histogram[(BYTE)c]++;
 
 
-	// ---- local stack for last direction matrix 
-		std::stack<D3DXMATRIX> direction_stack;  
+	// ---- symbols in big_string or a rule
+		BOOL used[256] = { FALSE };
+		for (INT a = 0; a < 256; a++)
+		{
+			used[a] = used[a] || histogram[a] > 0;
+			if ( production[a] != NULL )
+				for (CHAR c : *production[a]) used[(BYTE)c] = TRUE;
+		}
+		INT index[256];
+		std::vector<BYTE> symbol;
+		for (INT a = 0; a < 256; a++)
+		{
+			index[a] = (INT)symbol.size();
+			if ( used[a] ) symbol.push_back((BYTE)a);
+		}
+		size_t k = symbol.size();
 
 
-	// ---- set initial position vector
-		position_stack.push(D3DXVECTOR3(0.0f, 0.0f, 0.0f));
+	// ---- production count matrix, & symbol count vector
+		std::vector<UINT64> matrix(k * k, 0);
+		std::vector<UINT64> count(k);
+		for (size_t a = 0; a < k; a++)
+		{
+			const std::string *p = production[symbol[a]];
+			if ( p == NULL )
+				matrix[a * k + a] = 1;
+			else
+				for (CHAR c : *p) matrix[a * k + index[(BYTE)c]]++;
+			count[a] = histogram[symbol[a]];
+		}
 
 
-	// ---- set inital direction to identity
-		D3DXMATRIX initialDir;
-		D3DXMatrixIdentity( &initialDir );
+	// ---- count = count * matrix ^ generations, by squaring
+		std::vector<UINT64> temp;
+		while ( generations > 0 )
+		{
+			if ( generations & 1 )
+			{
+				temp.assign(k, 0);
+				for (size_t a = 0; a < k; a++)
+					for (size_t b = 0; b < k; b++)
+						temp[b] += count[a] * matrix[a * k + b];
+				count.swap(temp);
+			}
+			generations >>= 1;
+			if ( generations > 0 )
+			{
+				temp.assign(k * k, 0);
+				for (size_t a = 0; a < k; a++)
+					for (size_t c = 0; c < k; c++)
+						for (size_t b = 0; b < k; b++)
+							temp[a * k + b] += matrix[a * k + c] * matrix[c * k + b];
+				matrix.swap(temp);
+			}
+		}
 
+	return used['F'] ? 2 * count[index['F']] : 0;
+}
+
+
+// ---------- Lsystem_DrawTreeToBuffer ---------
+/*!
+\brief generate vertices based on L-system symbols into a caller's buffer
+\author Gareth Edwards
+\param LVertex * (buffer) e.g. verts, or a locked vertex buffer
+\param UINT64 (number_of_vertices) size of buffer
+\return HRESULT (SUCCESS_OK if ok, SUCCESS_FAULT if buffer is too small)
+\note vertices are only written, in order, so a D3DUSAGE_WRITEONLY
+vertex buffer can be filled directly, e.g.:
+
+	UINT64 n = Lsystem_GetVertexCount();
+	device->CreateVertexBuffer((UINT)n * sizeof(LVertex), D3DUSAGE_WRITEONLY,
+		LVertex::FVF_Flags, D3DPOOL_DEFAULT, &vertex_buffer, NULL);
+	LVertex *buffer;
+	vertex_buffer->Lock(0, 0, (VOID**)&buffer, 0);
+	Lsystem_DrawTreeToBuffer(buffer, n);
+	vertex_buffer->Unlock();
+
+\note a long string is interpreted concurrently (see vsl_lsystem_parallel.hpp)
+*/
+HRESULT LSystem::Lsystem_DrawTreeToBuffer(
+		LVertex *buffer,
+		UINT64 number_of_vertices
+	)
+{
+
+	// ---- room ?
+		if ( number_of_vertices < Lsystem_GetVertexCount() ) return SUCCESS_FAULT;
 
-	// ---- set initial stack direction
-		direction_stack.push(initialDir);
- 
 
-	// ---- iterate through string
-		for (INT i = 0; i < (INT)big_string.length(); i++)
+	// ---- parallel ? (else, e.g. if brackets unbalanced, serial)
+		if ( expand_mode == ExpandMode::STRING &&
+				number_of_threads != 1 &&
+					big_string.length() >= PARALLEL_MIN_LENGTH )
 		{
-				if ( big_string.at(i) == 'F' )
-				{   
+			if ( Lsystem_DrawTreeParallel(buffer) == SUCCESS_OK ) return SUCCESS_OK;
+		}
 
-					v.pos = position_stack.top();                                            // set position vector to last position  
-					verts.push_back(v);                                                      // add to list of vertices
 
-					D3DXVECTOR4 direction_temp;                                              // temporary 4D vector to store direction transform output 
-					D3DXVECTOR3 uP = D3DXVECTOR3(0, 1, 0);                                   // temporary 3D direction vector 
-					D3DXVec3Transform( &direction_temp, &uP, &direction_stack.top());        // transform by current direction
-					uP = D3DXVECTOR3(direction_temp.x, direction_temp.y, direction_temp.z);  // assign to temporary 3Dvector
-					D3DXVec3Normalize(&uP, &uP);                                             // normalize direction vector
+	// ---- set initial position & direction
+		Turtle turtle;
+		Lsystem_StartTurtle(&turtle, NULL);
 
-					D3DXVECTOR3 newPos = D3DXVECTOR3(0, 0, 0);                               // new position vector
-					newPos += ( uP * current_length );                                       // new position = direction vector * length of travel
-					D3DXMATRIX matTranslation;    
-					D3DXMatrixTranslation(&matTranslation,
-							position_stack.top().x,
-							position_stack.top().y,
-							position_stack.top().z
-						);  
-					D3DXVECTOR4 temp;                                                        // temporary 4D vector
-					D3DXVec3Transform(&temp, &newPos, &matTranslation);                      // calculate new vector
 
-					v.pos = D3DXVECTOR3(temp.x, temp.y, temp.z);                             // set new value for vpos
-					verts.push_back(v);                                                      // add to vertex list
-					position_stack.top() = D3DXVECTOR3(temp.x, temp.y, temp.z);              // and replace top of position stack
-				}
+	// ---- iterate through string, or streamed expansion
+		LVertex *out = buffer;
+		if ( expand_mode == ExpandMode::STREAMED )
+		{
+			Stream stream;
+			stream.Start(&big_string, production, stream_depth);
+			for (CHAR c = stream.Next(); c != 0; c = stream.Next())
+				Lsystem_Interpret(&turtle, c, &out);
+		}
+		else
+		{
+			for (INT i = 0; i < (INT)big_string.length(); i++)
+				Lsystem_Interpret(&turtle, big_string[i], &out);
+		}
 
-				if (big_string.at(i) == '^')                                                  // rotation transforms current direction in axis depending on CHAR
-				{
-					D3DXVECTOR3 lastDir = direction_stack.top();                             // get last direction
-					D3DXMatrixRotationZ(&zRotation, D3DXToRadian(current_angle));            // positive rotation around Z-axis
-					D3DXMatrixMultiply(&direction_stack.top(),
-						&zRotation, &direction_stack.top());
-				}
+	return SUCCESS_OK;
+}
 
-				if (big_string.at(i) == 'v')
-				{
-					D3DXVECTOR3 lastDir = direction_stack.top();                             // get last direction
-					D3DXMatrixRotationZ(&zRotation, D3DXToRadian(-current_angle));           // negative rotation around Z-axis
-					D3DXMatrixMultiply(&direction_stack.top(),
-						&zRotation, &direction_stack.top());
-				}
-   
-				if (big_string.at(i) == '>')
-				{
-					D3DXVECTOR3 lastDir = direction_stack.top();                             // get last direction
-					D3DXMatrixRotationY(&yRotation, D3DXToRadian(current_angle));            // positive rotation around Y-axis
-					D3DXMatrixMultiply(&direction_stack.top(),
-						&yRotation, &direction_stack.top());
-				}
-   
-				if (big_string.at(i) == '<')
-				{
-					D3DXVECTOR3 lastDir = direction_stack.top();                             // get last direction
-					D3DXMatrixRotationY(&yRotation, D3DXToRadian(-current_angle));           // negative rotation around Y-axis
-					D3DXMatrixMultiply(&direction_stack.top(),
-						&yRotation, &direction_stack.top());
-				}  
-   
-				if (big_string.at(i) == '+')
+
+// ---------- Lsystem_StartTurtle ---------
+/*!
+\brief set a turtle's rotations, position & direction, & empty its stack
+\author Gareth Edwards
+\param Turtle * (turtle)
+\param Turtle::State * (state) NULL for origin & identity direction
+\note rotations are as per D3DXMatrixRotationZ/Y/X(D3DXToRadian(+/-current_angle))
+*/
+VOID LSystem::Lsystem_StartTurtle(
+		Turtle *turtle,
+		const Turtle::State *state
+	)
+{
+
+	// ---- precompute rotations, 3x3 of each matrix, ^ v > < + - order
+		for ( INT r = Turtle::Z_POSITIVE; r <= Turtle::X_NEGATIVE; r++ )
+		{
+			D3DXMATRIX rotation;
+			FLOAT angle = D3DXToRadian( r % 2 == 0 ? current_angle : -current_angle );
+			switch ( r / 2 )
+			{
+				case 0 : D3DXMatrixRotationZ(&rotation, angle); break;
+				case 1 : D3DXMatrixRotationY(&rotation, angle); break;
+				case 2 : D3DXMatrixRotationX(&rotation, angle); break;
+			}
+			for ( INT i = 0; i < 3; i++ )
+				turtle->rotation[r][i] = _mm_set_ps(0, rotation.m[i][2], rotation.m[i][1], rotation.m[i][0]);
+		}
+
+	// ---- position & direction
+		if ( state == NULL )
+		{
+			turtle->position     = _mm_setzero_ps();
+			turtle->direction[0] = _mm_set_ps(0, 0, 0, 1);
+			turtle->direction[1] = _mm_set_ps(0, 0, 1, 0);
+			turtle->direction[2] = _mm_set_ps(0, 1, 0, 0);
+		}
+		else
+		{
+			turtle->position = _mm_loadu_ps(state->position);
+			for ( INT i = 0; i < 3; i++ )
+				turtle->direction[i] = _mm_loadu_ps(state->direction[i]);
+		}
+
+	// ---- empty stack, preallocated for typical branch depths
+		if ( turtle->stack.size() < 64 ) turtle->stack.resize(64);
+		turtle->depth = 0;
+
+}
+
+
+// ---------- Lsystem_GetTurtleState ---------
+/*!
+\brief get a turtle's current position & direction
+\author Gareth Edwards
+\param Turtle * (turtle)
+\param Turtle::State * (state) [out]
+*/
+VOID LSystem::Lsystem_GetTurtleState(
+		const Turtle *turtle,
+		Turtle::State *state
+	)
+{
+	_mm_storeu_ps(state->position, turtle->position);
+	for ( INT i = 0; i < 3; i++ )
+		_mm_storeu_ps(state->direction[i], turtle->direction[i]);
+}
+
+
+// ---------- Lsystem_Interpret ---------
+/*!
+\brief interpret one L-system symbol
+\author Gareth Edwards
+\param Turtle * (turtle)
+\param CHAR (c)
+\param LVertex ** (out) next vertex, advanced by 2 per 'F' (NULL to only move turtle)
+\note state is SSE, with direction rows x, y, z & "up" the y row, so...
+	F:           position += normalise(direction[1]) * current_length
+	^ v > < + -: direction = rotation * direction
+*/
+VOID LSystem::Lsystem_Interpret(
+		Turtle *turtle,
+		CHAR c,
+		LVertex **out
+	)
+{
+
+	// ---- symbol
+		Turtle::Rotation r;
+		switch ( c )
+		{
+
+			case 'F' :
 				{
-					D3DXVECTOR3 lastDir = direction_stack.top();                             // get last direction
-					D3DXMatrixRotationX(&xRotation, D3DXToRadian(current_angle));            // positive rotation around X-axis
-					D3DXMatrixMultiply(&direction_stack.top(),
-						&xRotation, &direction_stack.top());
+					FLOAT p[4];
+					if ( out != NULL )
+					{
+						_mm_storeu_ps(p, turtle->position);                          // add last position to vertices
+						(*out)++->pos = D3DXVECTOR3(p[0], p[1], p[2]);
+					}
+
+					__m128 up = turtle->direction[1];                                // direction y axis
+					__m128 sq = _mm_mul_ps(up, up);
+					__m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(               // broadcast |up|
+							_mm_shuffle_ps(sq, sq, _MM_SHUFFLE(0, 0, 0, 0)),
+							_mm_shuffle_ps(sq, sq, _MM_SHUFFLE(1, 1, 1, 1))),
+							_mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 2, 2, 2))
+						));
+					up = _mm_div_ps(up, length);                                     // normalize (rows are unit, bar rounding)
+					turtle->position = _mm_add_ps(                                   // new position = position + up * length of travel
+							_mm_mul_ps(up, _mm_set1_ps(current_length)),
+							turtle->position
+						);
+
+					if ( out != NULL )
+					{
+						_mm_storeu_ps(p, turtle->position);                          // add new position to vertices
+						(*out)++->pos = D3DXVECTOR3(p[0], p[1], p[2]);
+					}
 				}
-   
-				if (big_string.at(i) == '-')
-				{
-					D3DXVECTOR3 lastDir = direction_stack.top();                             // get last direction
-					D3DXMatrixRotationX(&xRotation, D3DXToRadian(-current_angle));           // negative rotation around X-axis
-					D3DXMatrixMultiply(&direction_stack.top(),
-						&xRotation, &direction_stack.top());
-				} 
+				return;
+
+			case '^' : r = Turtle::Z_POSITIVE; break;                                // positive rotation around Z-axis
+			case 'v' : r = Turtle::Z_NEGATIVE; break;                                // negative rotation around Z-axis
+			case '>' : r = Turtle::Y_POSITIVE; break;                                // positive rotation around Y-axis
+			case '<' : r = Turtle::Y_NEGATIVE; break;                                // negative rotation around Y-axis
+			case '+' : r = Turtle::X_POSITIVE; break;                                // positive rotation around X-axis
+			case '-' : r = Turtle::X_NEGATIVE; break;                                // negative rotation around X-axis
 
-				if (big_string.at(i) == '[')
+			case '[' :
 				{
-					position_stack.push(position_stack.top());                               // push current position onto position stack 
-					direction_stack.push(direction_stack.top());                             // push current direction onto direction stack 
+					if ( turtle->depth == (INT)turtle->stack.size() )                // grow stack (rare, see Lsystem_StartTurtle)
+						turtle->stack.resize(turtle->stack.size() * 2);
+					Turtle::State *s = &turtle->stack[turtle->depth++];              // push current position & direction
+					Lsystem_GetTurtleState(turtle, s);
 				}
+				return;
 
-				if (big_string.at(i) == ']')
+			case ']' :
 				{
-					position_stack.pop();                                                    // reset position stack to previous position 
-					direction_stack.pop();                                                   // reset direction stack to previous direction
+					if ( turtle->depth == 0 ) return;                                // unbalanced, so ignore
+					const Turtle::State *s = &turtle->stack[--turtle->depth];        // pop previous position & direction
+					turtle->position = _mm_loadu_ps(s->position);
+					for ( INT i = 0; i < 3; i++ )
+						turtle->direction[i] = _mm_loadu_ps(s->direction[i]);
 				}
+				return;
+
+			default :
+				return;
+		}
+
 
+	// ---- rotate, each row of direction = row of rotation * direction
+		const __m128 *m = turtle->rotation[r];
+		__m128 d0 = turtle->direction[0];
+		__m128 d1 = turtle->direction[1];
+		__m128 d2 = turtle->direction[2];
+		for ( INT i = 0; i < 3; i++ )
+		{
+			turtle->direction[i] = _mm_add_ps(_mm_add_ps(
+					_mm_mul_ps(_mm_shuffle_ps(m[i], m[i], _MM_SHUFFLE(0, 0, 0, 0)), d0),
+					_mm_mul_ps(_mm_shuffle_ps(m[i], m[i], _MM_SHUFFLE(1, 1, 1, 1)), d1)),
+					_mm_mul_ps(_mm_shuffle_ps(m[i], m[i], _MM_SHUFFLE(2, 2, 2, 2)), d2)
+				);
 		}
 
 }
@@ -811,9 +1176,8 @@ VOID LSystem::Lsystem_SelectVariable(INT var)
 			case 3:    // iteration depth 
 				{
 					iteration_depth += var;
-					big_string = axiom;
 					verts.clear();
-					Lsystem_Iterate(iteration_depth);
+					Lsystem_SetDepth(iteration_depth);   // from cached generations
 				}
 				break;
 
@@ -918,6 +1282,14 @@ VOID LSystem::Display_Text()
 			font->DrawText(NULL, (LPCSTR)text.c_str(), -1, &rct, 0, fontColor);
 			rct.top += 20; rct.bottom += 20;
 
+			text = "  Press 'S' to toggle streamed expansion";
+			font->DrawText(NULL, (LPCSTR)text.c_str(), -1, &rct, 0, fontColor);
+			rct.top += 20; rct.bottom += 20;
+
+			text = "  Press 'I' to toggle indexed line list";
+			font->DrawText(NULL, (LPCSTR)text.c_str(), -1, &rct, 0, fontColor);
+			rct.top += 20; rct.bottom += 20;
+
 			text = "  Press 'V' to display l-system info & variables";
 			font->DrawText(NULL, (LPCSTR)text.c_str(), -1, &rct, 0, fontColor );
 			rct.top += 20; rct.bottom += 20;
@@ -1002,4 +1374,12 @@ VOID LSystem::Display_AsyncKeyState()
 }
 
 
-////////////////////////////////////////////////////////////////////////////////
\ No newline at end of file
+////////////////////////////////////////////////////////////////////////////////
+
+#include "../hpp/vsl_lsystem_stream.hpp"
+#include "../hpp/vsl_lsystem_parallel.hpp"
+#include "../hpp/vsl_lsystem_indexed.hpp"
+#include "../hpp/vsl_lsystem_benchmark.hpp"
+
+
+////////////////////////////////////////////////////////////////////////////////
@@ -68,6 +68,85 @@ namespace vs_library
 		// ---- private implementation
 			class  PI_DotObjElement; PI_DotObjElement *pi_dot_obj_element;
 
+		// ---- arena node (see Add)
+			DotObjElement::DotObjElement(PI_DotObjElement *pi);
+
+	};
+
+
+	class DotObjMesh
+	{
+
+		public:
+
+		// ---- cdtor
+			DotObjMesh::DotObjMesh();
+			DotObjMesh::~DotObjMesh();
+
+		// ---- builder
+			VOID  Clear();
+			VOID  Reserve(INT positions, INT texcoords, INT normals, INT faces, INT corners);
+			VOID  Resize(INT positions, INT texcoords, INT normals, INT faces, INT corners);
+			VOID  ResizeNormals(INT normals);
+			VOID  Swap(DotObjMesh *mesh);  // exchange all arrays, O(1)
+			INT   AddPosition(FLOAT x, FLOAT y, FLOAT z);
+			INT   AddTexcoord(FLOAT u, FLOAT v);
+			INT   AddNormal(FLOAT x, FLOAT y, FLOAT z);
+			INT   AddFace();
+			INT   AddCorner(INT v, INT vt, INT vn);
+
+		// ---- size
+			INT   GetNumberOfPositions();
+			INT   GetNumberOfTexcoords();
+			INT   GetNumberOfNormals();
+			INT   GetNumberOfFaces();
+			INT   GetNumberOfCorners();
+
+		// ---- data (contiguous, one array per attribute)
+			FLOAT *GetPositions();
+			FLOAT *GetTexcoords();
+			FLOAT *GetNormals();
+			INT   *GetCorners();
+			INT   *GetFaces();
+
+		// ---- triangles (see DotObjUtilities::Triangulate)
+			VOID  ResizeTriangles(INT triangles);
+			INT   GetNumberOfTriangles();
+			INT  *GetTriangles();        // 3 corners per triangle
+
+		// ---- unique vertices (see DotObjUtilities::CreateUniqueVertices)
+			VOID  ResizeUnique(INT unique_vertices);
+			INT   GetNumberOfUniqueVertices();
+			INT  *GetUniqueVertices();   // first corner of each unique vertex
+			INT  *GetCornerVertices();   // unique vertex of each corner
+
+		// ---- bounds & bvh (see DotObjUtilities::ComputeBounds & BuildBvh)
+			struct BvhNode
+			{
+				FLOAT _min[3];
+				FLOAT _max[3];
+				INT   _first;                // leaf: first of GetBvhTriangles, else right child
+				INT   _count;                // leaf: # of triangles, else 0 (left child is next)
+			};
+			VOID     SetBounds(const FLOAT *min, const FLOAT *max);
+			BOOL     GetBounds(FLOAT *min, FLOAT *max);  // FALSE if empty
+			VOID     ResizeBvh(INT nodes, INT triangles);
+			INT      GetNumberOfBvhNodes();
+			BvhNode *GetBvhNodes();
+			INT     *GetBvhTriangles();  // index in GetTriangles
+
+		// ---- levels of detail (see DotObjUtilities::GenerateLods)
+			VOID   ResizeLods(INT lods, INT indices);
+			INT    GetNumberOfLods();    // excluding full detail
+			INT   *GetLodFirst();        // first index of each lod, # lods + 1
+			INT   *GetLodIndices();      // 3 unique vertices per triangle
+			FLOAT *GetLodErrors();       // of each lod, in position units
+
+	private:
+
+		// ---- private implementation
+			class  PI_DotObjMesh; PI_DotObjMesh *pi_dot_obj_mesh;
+
 	};
 
 
@@ -82,6 +161,25 @@ namespace vs_library
 				PROCESSED  = 2,
 			};
 
+			enum ReadMode
+			{
+				BUFFERED   = 1, // read whole file into a buffer, then parse
+				MAPPED     = 2, // parse directly from a read only file view
+			};
+
+			enum WriteMode
+			{
+				STREAMED   = 1, // format & write blocks on the calling thread
+				THREADED   = 2, // write full blocks on a background thread
+			};
+
+			enum NormalMode
+			{
+				FACE           = 1, // one normal per face
+				AREA_WEIGHTED  = 2, // smooth, faces weighted by area
+				ANGLE_WEIGHTED = 3, // smooth, faces weighted by corner angle
+			};
+
 		// ---- cdtor
 			DotObjUtilities::DotObjUtilities();
 			DotObjUtilities::~DotObjUtilities();
@@ -104,10 +202,79 @@ namespace vs_library
 			INT GetTriangleIndexBuffer(DotObjElement *object, DWORD *index_buffer, INT index_count);
 			INT GetTriangleVertexBuffer(DotObjElement *object, FLOAT *object_param, FLOAT *vertex_buffer, INT vertex_total, INT vertex_count);
 
+		// ---- mesh io framework
+			HRESULT Read(DotObjMesh *mesh, CHAR *filename);
+			HRESULT Report(DotObjMesh *mesh, CHAR *filename);
+			HRESULT Write(DotObjMesh *mesh, CHAR *filename);
+
+		// ---- mesh io mode
+			ReadMode GetReadMode();
+			VOID     SetReadMode(ReadMode mode);
+			INT      GetNumberOfThreads();
+			VOID     SetNumberOfThreads(INT number_of_threads);
+			BOOL     GetCacheMode();
+			VOID     SetCacheMode(BOOL cache_mode);
+			WriteMode GetWriteMode();
+			VOID      SetWriteMode(WriteMode mode);
+			BOOL     GetBvhMode();
+			VOID     SetBvhMode(BOOL bvh_mode);
+
+		// ---- mesh hot reload (see vsl_gfx_dotobj_watch.hpp)
+			HRESULT Watch(DotObjMesh *mesh, CHAR *filename);
+			HRESULT Unwatch();
+			BOOL    Reload(DotObjMesh *mesh);
+			INT     GetNumberOfReloads();
+
+		// ---- mesh get buffers
+			INT GetVertexBuffer(DotObjMesh *mesh, FLOAT *vertex_buffer, INT vertex_count, INT vertex_format);
+			INT GetNumberOfTriangles(DotObjMesh *mesh);
+			INT GetTriangleVertexBuffer(DotObjMesh *mesh, FLOAT *object_param, FLOAT *vertex_buffer, INT vertex_total, INT vertex_format);
+
+		// ---- mesh triangulate
+			HRESULT Triangulate(DotObjMesh *mesh);
+
+		// ---- mesh normals
+			HRESULT GenerateNormals(DotObjMesh *mesh, NormalMode mode, FLOAT crease_angle);
+
+		// ---- mesh get indexed buffers
+			INT CreateUniqueVertices(DotObjMesh *mesh);
+			INT GetIndexedVertexBuffer(DotObjMesh *mesh, FLOAT *object_param, FLOAT *vertex_buffer, INT vertex_total, INT vertex_format);
+			INT GetTriangleIndexBuffer(DotObjMesh *mesh, UINT *index_buffer, INT index_total);
+
+		// ---- mesh get packed buffers (see vsl_maths.h Vsl_Vertex_Packing)
+			INT GetPackedVertexSize(INT vertex_format, UINT packing);
+			INT GetPackedVertexBuffer(DotObjMesh *mesh, FLOAT *object_param, BYTE *packed_buffer, INT vertex_total, INT vertex_format, UINT packing, FLOAT *dequantise);
+
+		// ---- mesh bounds, bvh & queries
+			HRESULT ComputeBounds(DotObjMesh *mesh);
+			HRESULT BuildBvh(DotObjMesh *mesh);
+			BOOL    RayCast(DotObjMesh *mesh, const FLOAT *origin, const FLOAT *direction, FLOAT *distance, INT *triangle);
+			BOOL    InFrustum(DotObjMesh *mesh, const FLOAT *plane);
+
+		// ---- mesh levels of detail
+			HRESULT GenerateLods(DotObjMesh *mesh, INT number_of_lods, const FLOAT *ratio);
+			INT     GetLodNumberOfTriangles(DotObjMesh *mesh, INT lod);
+			INT     GetLodIndexBuffer(DotObjMesh *mesh, INT lod, UINT *index_buffer, INT index_total);
+
+		// ---- mesh optimise
+			FLOAT   GetACMR(DotObjMesh *mesh, INT cache_size);
+			HRESULT OptimiseMesh(DotObjMesh *mesh);
+
+		// ---- benchmark
+			HRESULT BenchmarkParse(INT number_of_faces, INT max_threads);
+			HRESULT BenchmarkScan(INT number_of_faces);
+			HRESULT BenchmarkWrite(INT number_of_faces, CHAR *filename);
+			HRESULT BenchmarkNormals(INT number_of_faces, INT max_threads);
+			HRESULT BenchmarkElement(INT number_of_faces);
+			HRESULT BenchmarkBvh(INT number_of_faces, INT number_of_rays);
+			HRESULT BenchmarkLods(INT number_of_faces, INT number_of_lods);
+			HRESULT BenchmarkPacking(INT number_of_faces);
+
 		// ---- methods to be made private
 			HRESULT CreateTagLists(DotObjElement *object);
 			HRESULT ParseData(DotObjElement *object, CHAR *data , INT size);
 			HRESULT ParseLine(DotObjElement *object, CHAR *data , INT len);
+			HRESULT ParseView(DotObjMesh *mesh, const CHAR *data, INT64 size);
 		
 		private:
 
@@ -66,6 +66,14 @@ namespace vsl_library
 				VOID SetIndexBuffer(LPDIRECT3DINDEXBUFFER9 index_buffer);
 				VOID SetConfigBitmask(UINT config_bitmask);
 
+			// ---- level of detail (optional, see Gfx_Element_Engine::Element_Display)
+				UINT    GetNumberOfLods(VOID);
+				VOID    GetLod(UINT lod, UINT *start_index, UINT *primitive_count);
+				VOID    GetLodBounds(D3DXVECTOR3 *centre, FLOAT *radius);
+				UINT    SelectLod(FLOAT projected_size);
+				HRESULT SetLod(UINT lod, UINT start_index, UINT primitive_count, FLOAT min_size);
+				VOID    SetLodBounds(D3DXVECTOR3 &centre, FLOAT radius);
+
 		private:
 
 			// ---- private implementation
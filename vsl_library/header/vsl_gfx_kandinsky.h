@@ -137,6 +137,10 @@ namespace vsl_library
 				UINT GetVertexFormatSize(VOID);
 				HRESULT SetVertexBufferSize(UINT vertex_buffer_size);
 
+			// ---- packed vertex (see vsl_maths.h Vsl_Vertex_Packing)
+				UINT GetPackedVertexFormatSize(UINT packing);
+				HRESULT GetPackedVertexBuffer(BYTE *packed_buffer, UINT packing, FLOAT *dequantise);
+
 			// ---- primitive
 				UINT GetPrimitiveCount(VOID);
 				UINT GetPrimitiveType(VOID);
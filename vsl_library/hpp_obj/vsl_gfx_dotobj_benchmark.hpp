@@ -0,0 +1,562 @@
+////////////////////////////////////////////////////////////////////////////////
+
+// ---------- vsl_gfx_dotobj_benchmark.hpp ----------
+/*!
+\file vsl_gfx_dotobj_benchmark.hpp
+\brief DotObjUtilities benchmark methods
+\author Gareth Edwards
+
+\note
+
+Benchmarks generate their ".obj" data in memory, so results do not
+depend on disk or file cache state, and report via OutputDebugString.
+
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- CreateGridData ----------
+/*!
+\brief create a synthetic ".obj" format triangulated grid
+\author Gareth Edwards
+\param std::string *data [out]
+\param INT number_of_faces [in] approximate # of triangles
+\param BOOL bumpy [in] if TRUE, y is 0.05 sin(40 x) cos(30 z), so (e.g.)
+collapse costs & ray hit heights vary, else the grid is flat
+\note each vertex has a position, texcoord & normal, so every face
+corner is "v/vt/vn", and the last row uses negative (relative) indices
+*/
+VOID DotObjUtilities::PI_DotObjUtilities::CreateGridData
+		(
+			std::string *data,   // [out]
+			INT number_of_faces, // [in]
+			BOOL bumpy           // [in]
+		)
+{
+
+	// ---- grid of n x n quads, two triangles per quad
+		INT n = (INT)sqrt((DOUBLE)number_of_faces / 2);
+		n = n < 1 ? 1 : n;
+		INT row = n + 1;
+
+	// ---- approximate size: ~64 bytes per vertex line set, ~40 per face
+		data->clear();
+		data->reserve((size_t)row * row * 64 + (size_t)n * n * 2 * 40);
+
+	// ---- vertices
+		CHAR line[128];
+		*data += "# vsl synthetic grid\n";
+		for ( INT j = 0; j < row; j++ )
+		{
+			for ( INT i = 0; i < row; i++ )
+			{
+				FLOAT u = (FLOAT)i / n, v = (FLOAT)j / n;
+				FLOAT x = u - 0.5f, z = v - 0.5f;
+				FLOAT y = bumpy ? 0.05f * (FLOAT)( sin(x * 40) * cos(z * 30) ) : 0.0f;
+				sprintf_s(line, 128, "v %.6f %.6f %.6f\n", x, y, z);
+				*data += line;
+				sprintf_s(line, 128, "vt %.6f %.6f\n", u, v);
+				*data += line;
+				*data += "vn 0.000000 1.000000 0.000000\n";
+			}
+		}
+
+	// ---- faces
+		INT total = row * row;
+		for ( INT j = 0; j < n; j++ )
+		{
+			for ( INT i = 0; i < n; i++ )
+			{
+				INT a = j * row + i + 1, b = a + 1, c = a + row, d = c + 1;
+				if ( j == n - 1 )
+				{
+					a -= total + 1; b -= total + 1; c -= total + 1; d -= total + 1;
+				}
+				sprintf_s(line, 128, "f %d/%d/%d %d/%d/%d %d/%d/%d\n", a, a, a, c, c, c, b, b, b);
+				*data += line;
+				sprintf_s(line, 128, "f %d/%d/%d %d/%d/%d %d/%d/%d\n", b, b, b, c, c, c, d, d, d);
+				*data += line;
+			}
+		}
+
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- benchmark ----------
+
+
+// ---------- BenchmarkParse ----------
+/*!
+\brief benchmark parsing a synthetic grid with 1 to max_threads threads
+\author Gareth Edwards
+\param INT number_of_faces [in] approximate # of triangles (e.g. 10000000)
+\param INT max_threads [in] (<= 0 is one per hardware thread)
+\return HRESULT (SUCCESS_OK if ok, and every thread count produced the same mesh)
+*/
+HRESULT DotObjUtilities::BenchmarkParse(
+		INT number_of_faces,
+		INT max_threads
+	)
+{
+
+	// ---- local
+		using namespace std::chrono;
+		INT number_of_threads = pi_dot_obj_utilities->_number_of_threads;
+		if ( max_threads <= 0 )
+		{
+			max_threads = (INT)std::thread::hardware_concurrency();
+			max_threads = max_threads < 1 ? 1 : max_threads;
+		}
+
+	// ---- data
+		std::string data;
+		pi_dot_obj_utilities->CreateGridData(&data, number_of_faces, FALSE);
+		DOUBLE megabytes = (DOUBLE)data.size() / (1024 * 1024);
+
+	// ---- tell
+		CHAR msg[256];
+		sprintf_s(msg, 256, "BenchmarkParse: %.1f MB\n", megabytes);
+		OutputDebugString(msg);
+
+	// ---- for each # of threads
+		HRESULT result = SUCCESS_OK;
+		DOUBLE one_thread_ms = 0;
+		INT    one_thread_corners = 0;
+		for ( INT t = 1; t <= max_threads; t++ )
+		{
+			DotObjMesh mesh;
+			pi_dot_obj_utilities->_number_of_threads = t;
+
+			auto start = high_resolution_clock::now();
+			HRESULT hr = ParseView(&mesh, data.data(), (INT64)data.size());
+			DOUBLE ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - start).count();
+
+			if ( t == 1 )
+			{
+				one_thread_ms = ms;
+				one_thread_corners = mesh.GetNumberOfCorners();
+			}
+			if ( hr != SUCCESS_OK || mesh.GetNumberOfCorners() != one_thread_corners )
+				result = SUCCESS_FAULT;
+
+			sprintf_s(msg, 256, "   %2d threads - %9.1f ms %8.1f MB/s %5.2fx - %d faces %s\n",
+					t,
+					ms,
+					megabytes / (ms / 1000),
+					one_thread_ms / ms,
+					mesh.GetNumberOfFaces(),
+					hr == SUCCESS_OK ? "" : "(FAULT)"
+				);
+			OutputDebugString(msg);
+		}
+
+	// ---- restore
+		pi_dot_obj_utilities->_number_of_threads = number_of_threads;
+
+	return result;
+}
+
+
+// ---------- BenchmarkScan ----------
+/*!
+\brief benchmark per line numeric conversion of a synthetic grid
+\author Gareth Edwards
+\param INT number_of_faces [in] approximate # of triangles
+\return HRESULT (SUCCESS_OK if ok, and both methods produced the same values)
+
+\note
+
+   "crt"  - as ParseLine: Split each line, atof each vertex word, then
+            expand "//" to "/0/", Split on '/' and atoi each face field
+
+   "scan" - as ParseChunk: ClassifyLine, then ScanFloat & ScanInt in place
+
+Only the conversion is timed, nothing is stored, and both sum what they
+convert so the results can be compared.
+
+*/
+HRESULT DotObjUtilities::BenchmarkScan(
+		INT number_of_faces
+	)
+{
+
+	// ---- local
+		using namespace std::chrono;
+		PI_DotObjUtilities *pi = pi_dot_obj_utilities;
+
+	// ---- data
+		std::string data;
+		pi->CreateGridData(&data, number_of_faces, FALSE);
+		DOUBLE megabytes = (DOUBLE)data.size() / (1024 * 1024);
+		const CHAR *end = data.data() + data.size();
+
+	// ---- crt: copy, split, atof & atoi
+		DOUBLE crt_float_sum = 0;
+		INT64  crt_int_sum = 0;
+		auto crt_start = high_resolution_clock::now();
+		{
+			CHAR line_buffer[256];
+			for ( const CHAR *line = data.data(); line < end; )
+			{
+				const CHAR *eol = (const CHAR *)memchr(line, '\n', (size_t)(end - line));
+				if ( eol == NULL ) eol = end;
+				INT len = (INT)(eol - line);
+				len = len < 255 ? len : 255;
+				memcpy(line_buffer, line, len);
+				line = eol + 1;
+
+				CHAR *word[64];
+				UINT  word_count = 0;
+				pi->Split(word, &word_count, ' ', line_buffer, len);
+				if ( word_count == 0 ) continue;
+				switch ( pi->GetTagId(word[0]) )
+				{
+					case DotObjElement::TagId::VERTEX_GEOMETRY:
+					case DotObjElement::TagId::VERTEX_TEXTURE:
+					case DotObjElement::TagId::VERTEX_NORMAL:
+						for ( UINT w = 1; w < word_count; w++ )
+							crt_float_sum += (FLOAT)atof(word[w]);
+						break;
+					case DotObjElement::TagId::ELEMENT_FACE:
+						for ( UINT w = 1; w < word_count; w++ )
+						{
+							CHAR expanded_word[256];
+							INT  expanded_word_len = -1;
+							CHAR last_c = '/';
+							for ( CHAR *c = word[w]; *c && expanded_word_len < 250; c++ )
+							{
+								if ( last_c == '/' && *c == '/' ) expanded_word[++expanded_word_len] = '0';
+								expanded_word[++expanded_word_len] = *c;
+								last_c = *c;
+							}
+							expanded_word[++expanded_word_len] = '\0';
+							CHAR *elem_word[64];
+							UINT  elem_word_count = 0;
+							pi->Split(elem_word, &elem_word_count, '/', expanded_word, expanded_word_len);
+							for ( UINT ew = 0; ew < elem_word_count; ew++ )
+								crt_int_sum += atoi(elem_word[ew]);
+						}
+						break;
+					default:
+						break;
+				}
+			}
+		}
+		DOUBLE crt_ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - crt_start).count();
+
+	// ---- scan: classify, then scan in place
+		DOUBLE scan_float_sum = 0;
+		INT64  scan_int_sum = 0;
+		auto scan_start = high_resolution_clock::now();
+		{
+			for ( const CHAR *line = data.data(); line < end; )
+			{
+				const CHAR *eol = (const CHAR *)memchr(line, '\n', (size_t)(end - line));
+				if ( eol == NULL ) eol = end;
+				const CHAR *c = line;
+				line = eol + 1;
+
+				switch ( pi->ClassifyLine(&c, eol) )
+				{
+					case DotObjElement::TagId::VERTEX_GEOMETRY:
+					case DotObjElement::TagId::VERTEX_TEXTURE:
+					case DotObjElement::TagId::VERTEX_NORMAL:
+						while ( c < eol )
+						{
+							if ( *c == ' ' || *c == '\t' || *c == '\r' ) { c++; continue; }
+							const CHAR *start = c;
+							scan_float_sum += pi->ScanFloat(&c, eol);
+							if ( c == start ) c++;
+						}
+						break;
+					case DotObjElement::TagId::ELEMENT_FACE:
+						while ( c < eol )
+						{
+							if ( *c == ' ' || *c == '\t' || *c == '\r' || *c == '/' ) { c++; continue; }
+							const CHAR *start = c;
+							scan_int_sum += pi->ScanInt(&c, eol);
+							if ( c == start ) c++;
+						}
+						break;
+					default:
+						break;
+				}
+			}
+		}
+		DOUBLE scan_ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - scan_start).count();
+
+	// ---- tell
+		CHAR msg[256];
+		sprintf_s(msg, 256, "BenchmarkScan: %.1f MB\n", megabytes);
+		OutputDebugString(msg);
+		sprintf_s(msg, 256, "   crt  - %9.1f ms %8.1f MB/s\n", crt_ms, megabytes / (crt_ms / 1000));
+		OutputDebugString(msg);
+		sprintf_s(msg, 256, "   scan - %9.1f ms %8.1f MB/s %5.2fx\n", scan_ms, megabytes / (scan_ms / 1000), crt_ms / scan_ms);
+		OutputDebugString(msg);
+
+	// ---- same ?
+		BOOL same = crt_int_sum == scan_int_sum && crt_float_sum == scan_float_sum;
+		if ( !same ) OutputDebugString("   (FAULT) crt & scan values differ\n");
+
+	return same ? SUCCESS_OK : SUCCESS_FAULT;
+}
+
+
+// ---------- BenchmarkWrite ----------
+/*!
+\brief benchmark writing a synthetic grid as a ".obj" file
+\author Gareth Edwards
+\param INT number_of_faces [in] approximate # of triangles
+\param CHAR *filename [in] temporary ".obj" path/file name (deleted after)
+\return HRESULT (SUCCESS_OK if ok, and the file read back as the same mesh)
+
+\note
+
+   "crt"      - as the previous Write: sprintf " %f" each value into a
+                line string, append lines to a 100000 byte std::string
+                and stream that through std::ofstream
+
+   "streamed" - Write(DotObjMesh *) in STREAMED mode
+
+   "threaded" - Write(DotObjMesh *) in THREADED mode
+
+MB/s is of the file written by each, so includes the disk (or file
+cache), and the "threaded" file is read back and compared exactly.
+
+*/
+HRESULT DotObjUtilities::BenchmarkWrite(
+		INT number_of_faces,
+		CHAR *filename
+	)
+{
+
+	// ---- local
+		using namespace std::chrono;
+		PI_DotObjUtilities *pi = pi_dot_obj_utilities;
+		WriteMode write_mode = pi->_write_mode;
+
+	// ---- mesh
+		DotObjMesh mesh;
+		{
+			std::string data;
+			pi->CreateGridData(&data, number_of_faces, FALSE);
+			if ( ParseView(&mesh, data.data(), (INT64)data.size()) != SUCCESS_OK ) return SUCCESS_FAULT;
+		}
+
+	// ---- lambda: size of file in MB
+		auto file_megabytes = [filename]()
+		{
+			std::ifstream file(filename, std::ios::in | std::ios::binary | std::ios::ate);
+			return file.is_open() ? (DOUBLE)file.tellg() / (1024 * 1024) : 0;
+		};
+
+	// ---- crt
+		auto crt_start = high_resolution_clock::now();
+		{
+			std::ofstream output_stream(filename);
+			std::string output_buffer;
+			output_buffer.reserve(100000);
+			std::string buffer;
+			CHAR c[128];
+			auto write_output_buffer = [&]()
+			{
+				if ( output_buffer.length() + buffer.length() + 1 >= 100000 )
+				{
+					output_stream << output_buffer;
+					output_buffer.resize(0);
+				}
+				output_buffer.append(buffer);
+				output_buffer.append(1, '\n');
+			};
+			auto write_vertices = [&](const CHAR *tag_name, const FLOAT *value, INT number_of_vertices, INT number_of_values)
+			{
+				for ( INT i = 0; i < number_of_vertices; i++ )
+				{
+					buffer.assign(tag_name);
+					for ( INT n = 0; n < number_of_values; n++ )
+					{
+						sprintf_s(c, 128, " %f", *value++);
+						buffer += c;
+					}
+					write_output_buffer();
+				}
+			};
+			write_vertices("v",  mesh.GetPositions(), mesh.GetNumberOfPositions(), 3);
+			write_vertices("vt", mesh.GetTexcoords(), mesh.GetNumberOfTexcoords(), 2);
+			write_vertices("vn", mesh.GetNormals(),   mesh.GetNumberOfNormals(),   3);
+			INT *face   = mesh.GetFaces();
+			INT *corner = mesh.GetCorners();
+			for ( INT f = 0; f < mesh.GetNumberOfFaces(); f++ )
+			{
+				buffer.assign("f");
+				for ( INT k = face[f]; k < face[f + 1]; k++ )
+				{
+					INT *v = corner + k * 3;
+					sprintf_s(c, 128, " %d/%d/%d", v[0] + 1, v[1] + 1, v[2] + 1);
+					buffer += c;
+				}
+				write_output_buffer();
+			}
+			output_stream << output_buffer;
+		}
+		DOUBLE crt_ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - crt_start).count();
+		DOUBLE crt_megabytes = file_megabytes();
+
+	// ---- streamed
+		pi->_write_mode = WriteMode::STREAMED;
+		auto streamed_start = high_resolution_clock::now();
+		HRESULT streamed_hr = Write(&mesh, filename);
+		DOUBLE streamed_ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - streamed_start).count();
+		DOUBLE streamed_megabytes = file_megabytes();
+
+	// ---- threaded
+		pi->_write_mode = WriteMode::THREADED;
+		auto threaded_start = high_resolution_clock::now();
+		HRESULT threaded_hr = Write(&mesh, filename);
+		DOUBLE threaded_ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - threaded_start).count();
+		DOUBLE threaded_megabytes = file_megabytes();
+
+	// ---- restore
+		pi->_write_mode = write_mode;
+
+	// ---- read back
+		DotObjMesh read_mesh;
+		BOOL cache_mode = pi->_cache_mode;
+		pi->_cache_mode = FALSE;
+		HRESULT read_hr = Read(&read_mesh, filename);
+		pi->_cache_mode = cache_mode;
+		DeleteFile(filename);
+
+	// ---- same ?
+		BOOL same = streamed_hr == SUCCESS_OK && threaded_hr == SUCCESS_OK && read_hr == SUCCESS_OK &&
+			read_mesh.GetNumberOfPositions() == mesh.GetNumberOfPositions() &&
+			read_mesh.GetNumberOfTexcoords() == mesh.GetNumberOfTexcoords() &&
+			read_mesh.GetNumberOfNormals()   == mesh.GetNumberOfNormals()   &&
+			read_mesh.GetNumberOfFaces()     == mesh.GetNumberOfFaces()     &&
+			read_mesh.GetNumberOfCorners()   == mesh.GetNumberOfCorners();
+		if ( same )
+		{
+			same =
+				memcmp(read_mesh.GetPositions(), mesh.GetPositions(), mesh.GetNumberOfPositions() * 3 * sizeof(FLOAT)) == 0 &&
+				memcmp(read_mesh.GetTexcoords(), mesh.GetTexcoords(), mesh.GetNumberOfTexcoords() * 2 * sizeof(FLOAT)) == 0 &&
+				memcmp(read_mesh.GetNormals(),   mesh.GetNormals(),   mesh.GetNumberOfNormals()   * 3 * sizeof(FLOAT)) == 0 &&
+				memcmp(read_mesh.GetFaces(),     mesh.GetFaces(),     (mesh.GetNumberOfFaces() + 1) * sizeof(INT))     == 0 &&
+				memcmp(read_mesh.GetCorners(),   mesh.GetCorners(),   mesh.GetNumberOfCorners()   * 3 * sizeof(INT))   == 0;
+		}
+
+	// ---- tell
+		CHAR msg[256];
+		sprintf_s(msg, 256, "BenchmarkWrite: %d faces\n", mesh.GetNumberOfFaces());
+		OutputDebugString(msg);
+		sprintf_s(msg, 256, "   crt      - %9.1f ms %8.1f MB %8.1f MB/s\n",
+				crt_ms, crt_megabytes, crt_megabytes / (crt_ms / 1000));
+		OutputDebugString(msg);
+		sprintf_s(msg, 256, "   streamed - %9.1f ms %8.1f MB %8.1f MB/s %5.2fx\n",
+				streamed_ms, streamed_megabytes, streamed_megabytes / (streamed_ms / 1000), crt_ms / streamed_ms);
+		OutputDebugString(msg);
+		sprintf_s(msg, 256, "   threaded - %9.1f ms %8.1f MB %8.1f MB/s %5.2fx\n",
+				threaded_ms, threaded_megabytes, threaded_megabytes / (threaded_ms / 1000), crt_ms / threaded_ms);
+		OutputDebugString(msg);
+		if ( !same ) OutputDebugString("   (FAULT) written & read back meshes differ\n");
+
+	return same ? SUCCESS_OK : SUCCESS_FAULT;
+}
+
+
+// ---------- BenchmarkElement ----------
+/*!
+\brief benchmark loading & unloading a synthetic grid as an element tree
+\author Gareth Edwards
+\param INT number_of_faces [in] approximate # of triangles (e.g. 2000000, ~1M vertices)
+\return HRESULT (SUCCESS_OK if ok)
+
+\note
+
+   "arena" - CreateTagLists & ParseData into a root (as Read, without
+             the file), then delete the root, releasing the arena
+
+   "nodes" - the same # of nodes, with no parse: Add to a root, then
+             delete the root (arena), or new & delete one by one (heap,
+             as Add did before the arena - two allocations per node)
+
+*/
+HRESULT DotObjUtilities::BenchmarkElement(
+		INT number_of_faces
+	)
+{
+
+	// ---- local
+		using namespace std::chrono;
+		PI_DotObjUtilities *pi = pi_dot_obj_utilities;
+
+	// ---- data
+		std::string data;
+		pi->CreateGridData(&data, number_of_faces, FALSE);
+		INT size = (INT)data.size();
+		if ( pi->Scrub(&data[0], &size) != SUCCESS_OK ) return SUCCESS_FAULT;
+
+	// ---- arena: load
+		auto load_start = high_resolution_clock::now();
+		DotObjElement *object = new DotObjElement();
+		HRESULT hr = CreateTagLists(object);
+		if ( hr == SUCCESS_OK ) hr = ParseData(object, &data[0], size);
+		DOUBLE load_ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - load_start).count();
+
+	// ---- # of nodes & vertices
+		INT number_of_nodes = 0;
+		INT number_of_vertices = 0;
+		for ( DotObjElement *list = object->GetFirst(); list; list = list->GetNext() )
+		{
+			number_of_nodes++;
+			for ( DotObjElement *element = list->GetFirst(); element; element = element->GetNext() )
+			{
+				number_of_nodes++;
+				if ( list->GetTagId() == DotObjElement::TagId::VERTEX_GEOMETRY ) number_of_vertices++;
+				for ( DotObjElement *part = element->GetFirst(); part; part = part->GetNext() )
+					number_of_nodes++;
+			}
+		}
+
+	// ---- arena: unload
+		auto unload_start = high_resolution_clock::now();
+		delete object;
+		DOUBLE unload_ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - unload_start).count();
+
+	// ---- nodes: arena
+		auto add_start = high_resolution_clock::now();
+		DotObjElement *root = new DotObjElement();
+		for ( INT n = 0; n < number_of_nodes; n++ ) root->Add(DotObjElement::TagId::UNDEFINED);
+		DOUBLE add_ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - add_start).count();
+		auto release_start = high_resolution_clock::now();
+		delete root;
+		DOUBLE release_ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - release_start).count();
+
+	// ---- nodes: heap
+		std::vector<DotObjElement *> node(number_of_nodes);
+		auto new_start = high_resolution_clock::now();
+		for ( auto &n : node ) n = new DotObjElement();
+		DOUBLE new_ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - new_start).count();
+		auto delete_start = high_resolution_clock::now();
+		for ( auto n : node ) delete n;
+		DOUBLE delete_ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - delete_start).count();
+
+	// ---- tell
+		CHAR msg[256];
+		sprintf_s(msg, 256, "BenchmarkElement: %d vertices, %d nodes\n", number_of_vertices, number_of_nodes);
+		OutputDebugString(msg);
+		sprintf_s(msg, 256, "   grid          - load  %9.1f ms, unload %9.1f ms\n", load_ms, unload_ms);
+		OutputDebugString(msg);
+		sprintf_s(msg, 256, "   nodes (arena) - add   %9.1f ms, delete %9.1f ms\n", add_ms, release_ms);
+		OutputDebugString(msg);
+		sprintf_s(msg, 256, "   nodes (heap)  - new   %9.1f ms, delete %9.1f ms\n", new_ms, delete_ms);
+		OutputDebugString(msg);
+
+	return hr;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,676 @@
+////////////////////////////////////////////////////////////////////////////////
+
+// ---------- vsl_gfx_dotobj_bvh.hpp ----------
+/*!
+\file vsl_gfx_dotobj_bvh.hpp
+\brief DotObjUtilities flat mesh bounds, bvh & ray cast methods
+\author Gareth Edwards
+
+\note
+
+Read(DotObjMesh *) always computes the mesh bounds (an AABB of its
+positions), and with bvh mode on also builds a bounding volume
+hierarchy over its triangles, so a big mesh can be culled (InFrustum)
+and picked (RayCast) without a pass over every triangle.
+
+BuildBvh is a binned surface area heuristic (SAH) build:
+
+   1. triangle bounds & centroids, for each triangle range (one per
+      thread for big meshes)
+
+   2. top down, split each node's triangles on the axis of greatest
+      centroid extent, at the best of BVH_BINS - 1 planes by SAH cost,
+      until a node has BVH_LEAF_SIZE or fewer triangles, or splitting
+      costs more than not, where below BVH_MAX_DEPTH a node is split at
+      its median centroid instead, so a tree of up to 2^31 triangles is
+      at most BVH_MAX_DEPTH + 29 deep, & RayCast's fixed size stack of
+      BVH_STACK_SIZE nodes can NOT overflow
+
+   3. the first few levels build their right child on another thread
+      into a node array of its own, which is then appended, so the
+      result is the same for any # of threads
+
+Nodes are depth first: a node's left child is the next node, and an
+interior node's _first is its right child. A leaf's _first & _count
+select its triangles from GetBvhTriangles.
+
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- mesh bounds & bvh mode ----------
+
+BOOL DotObjUtilities::GetBvhMode()
+{
+	return pi_dot_obj_utilities->_bvh_mode;
+}
+
+VOID DotObjUtilities::SetBvhMode(BOOL bvh_mode)
+{
+	pi_dot_obj_utilities->_bvh_mode = bvh_mode;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- ComputeBounds ----------
+/*!
+\brief compute the bounds (AABB) of a flat mesh's positions
+\author Gareth Edwards
+\param DotObjMesh *mesh [in & out]
+\return HRESULT (SUCCESS_OK if ok)
+\note a mesh with no positions has empty bounds (see GetBounds)
+*/
+HRESULT DotObjUtilities::ComputeBounds(
+		DotObjMesh *mesh
+	)
+{
+
+	// ---- check
+		if ( mesh == NULL ) return SUCCESS_FAULT;
+
+	// ---- local
+		FLOAT *position = mesh->GetPositions();
+		INT number_of_positions = mesh->GetNumberOfPositions();
+		FLOAT min[3] = {  FLT_MAX,  FLT_MAX,  FLT_MAX };
+		FLOAT max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+	// ---- for each position
+		for ( INT v = 0; v < number_of_positions; v++ )
+		{
+			FLOAT *p = position + v * 3;
+			for ( INT a = 0; a < 3; a++ )
+			{
+				min[a] = p[a] < min[a] ? p[a] : min[a];
+				max[a] = p[a] > max[a] ? p[a] : max[a];
+			}
+		}
+
+	// ---- store
+		mesh->SetBounds(min, max);
+
+	return SUCCESS_OK;
+}
+
+
+// ---------- BuildBvh ----------
+/*!
+\brief build a SAH bounding volume hierarchy over a flat mesh's triangles
+\author Gareth Edwards
+\param DotObjMesh *mesh [in & out]
+\return HRESULT (SUCCESS_OK if ok, SUCCESS_FAULT if a geometry index is out of range)
+\note triangulates the mesh first, if required
+*/
+HRESULT DotObjUtilities::BuildBvh(
+		DotObjMesh *mesh
+	)
+{
+
+	// ---- check
+		if ( mesh == NULL ) return SUCCESS_FAULT;
+
+	// ---- triangulated ?
+		INT number_of_triangles = GetNumberOfTriangles(mesh);
+		if ( mesh->GetNumberOfTriangles() != number_of_triangles )
+			if ( Triangulate(mesh) != SUCCESS_OK ) return SUCCESS_FAULT;
+		mesh->ResizeBvh(0, 0);
+		if ( number_of_triangles == 0 ) return SUCCESS_OK;
+
+	// ---- local
+		INT   *triangle = mesh->GetTriangles();
+		INT   *corner   = mesh->GetCorners();
+		FLOAT *position = mesh->GetPositions();
+		INT    number_of_positions = mesh->GetNumberOfPositions();
+
+	// ---- # of threads
+		INT number_of_threads = pi_dot_obj_utilities->_number_of_threads;
+		if ( number_of_threads <= 0 )
+		{
+			number_of_threads = (INT)std::thread::hardware_concurrency();
+			number_of_threads = number_of_threads < 1 ? 1 : number_of_threads;
+		}
+
+	// ---- lambda: # of ranges of items (small counts are NOT split)
+		auto get_number_of_ranges = [number_of_threads](INT number_of_items)
+		{
+			const INT min_items_per_range = 1 << 16;
+			INT number_of_ranges = number_of_items / min_items_per_range;
+			return number_of_ranges < 1 ? 1 :
+				( number_of_ranges > number_of_threads ? number_of_threads : number_of_ranges );
+		};
+
+	// ---- lambda: invoke function(range index) once per range, concurrently if > 1
+		auto for_each_range = [](INT number_of_ranges, auto function)
+		{
+			if ( number_of_ranges == 1 )
+			{
+				function(0);
+				return;
+			}
+			std::vector<std::thread> thread;
+			thread.reserve(number_of_ranges - 1);
+			for ( INT r = 1; r < number_of_ranges; r++ )
+				thread.push_back(std::thread(function, r));
+			function(0);
+			for ( auto &t : thread ) t.join();
+		};
+
+	// ---- lambda: first item of a range
+		auto range_first = [](INT number_of_items, INT number_of_ranges, INT r)
+		{
+			return (INT)( (INT64)number_of_items * r / number_of_ranges );
+		};
+
+	// ---- 1. triangle bounds & centroids, for each triangle range
+		PI_DotObjUtilities::DotObjBvhBuild build;
+		build._box.resize(number_of_triangles * 6);
+		build._centroid.resize(number_of_triangles * 3);
+		build._index.resize(number_of_triangles);
+		INT number_of_ranges = get_number_of_ranges(number_of_triangles);
+		std::vector<HRESULT> result(number_of_ranges, SUCCESS_OK);
+		for_each_range(number_of_ranges, [&](INT r)
+		{
+			INT first = range_first(number_of_triangles, number_of_ranges, r);
+			INT last  = range_first(number_of_triangles, number_of_ranges, r + 1);
+			for ( INT t = first; t < last; t++ )
+			{
+				FLOAT *box = build._box.data() + t * 6;
+				box[0] = box[1] = box[2] =  FLT_MAX;
+				box[3] = box[4] = box[5] = -FLT_MAX;
+				for ( INT i = 0; i < 3; i++ )
+				{
+					INT v = *(corner + *(triangle + t * 3 + i) * 3);
+					if ( v < 0 || v >= number_of_positions )
+					{
+						result[r] = SUCCESS_FAULT;
+						v = 0;
+					}
+					FLOAT *p = position + v * 3;
+					for ( INT a = 0; a < 3; a++ )
+					{
+						box[a]     = p[a] < box[a]     ? p[a] : box[a];
+						box[a + 3] = p[a] > box[a + 3] ? p[a] : box[a + 3];
+					}
+				}
+				for ( INT a = 0; a < 3; a++ )
+					build._centroid[t * 3 + a] = ( box[a] + box[a + 3] ) * 0.5f;
+				build._index[t] = t;
+			}
+		});
+		for ( auto hr : result ) if ( hr != SUCCESS_OK ) return SUCCESS_FAULT;
+
+	// ---- 2. & 3. nodes, top down (right child threaded to depth log2 # threads)
+		build._parallel_depth = 0;
+		while ( ( 1 << build._parallel_depth ) < number_of_threads ) build._parallel_depth++;
+		std::vector<DotObjMesh::BvhNode> node;
+		node.reserve(number_of_triangles / PI_DotObjUtilities::DotObjBvhBuild::BVH_LEAF_SIZE * 2 + 1);
+		pi_dot_obj_utilities->BuildBvhNode(&build, &node, 0, number_of_triangles, 0);
+
+	// ---- store
+		mesh->ResizeBvh((INT)node.size(), number_of_triangles);
+		memcpy(mesh->GetBvhNodes(), node.data(), node.size() * sizeof(DotObjMesh::BvhNode));
+		memcpy(mesh->GetBvhTriangles(), build._index.data(), number_of_triangles * sizeof(INT));
+
+	return SUCCESS_OK;
+}
+
+
+// ---------- RayCast ----------
+/*!
+\brief find the nearest triangle of a flat mesh hit by a ray
+\author Gareth Edwards
+\param DotObjMesh *mesh [in]
+\param const FLOAT *origin [in] x, y, z
+\param const FLOAT *direction [in] x, y, z (need not be unit)
+\param FLOAT *distance [out] along ray, in units of direction
+\param INT *triangle [out] index in GetTriangles
+\return BOOL TRUE if hit
+\note both sides of a triangle are hit; without a bvh every triangle is tested
+*/
+BOOL DotObjUtilities::RayCast(
+		DotObjMesh *mesh,
+		const FLOAT *origin,
+		const FLOAT *direction,
+		FLOAT *distance,
+		INT *triangle
+	)
+{
+
+	// ---- check
+		if ( mesh == NULL || origin == NULL || direction == NULL ) return FALSE;
+
+	// ---- local
+		const FLOAT *o = origin, *d = direction;
+		INT   *tri      = mesh->GetTriangles();
+		INT   *corner   = mesh->GetCorners();
+		FLOAT *position = mesh->GetPositions();
+		INT    number_of_triangles = mesh->GetNumberOfTriangles();
+		INT    number_of_positions = mesh->GetNumberOfPositions();
+		FLOAT  nearest = FLT_MAX;
+		INT    hit = -1;
+
+	// ---- lambda: Moller-Trumbore ray/triangle test, updating nearest
+		auto test_triangle = [&](INT t)
+		{
+			const FLOAT *p[3];
+			for ( INT i = 0; i < 3; i++ )
+			{
+				INT v = *(corner + *(tri + t * 3 + i) * 3);
+				if ( v < 0 || v >= number_of_positions ) return;
+				p[i] = position + v * 3;
+			}
+			FLOAT e1[3] = { p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2] };
+			FLOAT e2[3] = { p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2] };
+			FLOAT q[3]  = { d[1] * e2[2] - d[2] * e2[1], d[2] * e2[0] - d[0] * e2[2], d[0] * e2[1] - d[1] * e2[0] };
+			FLOAT det   = e1[0] * q[0] + e1[1] * q[1] + e1[2] * q[2];
+			if ( det == 0 ) return;
+			FLOAT inv = 1 / det;
+			FLOAT s[3]  = { o[0] - p[0][0], o[1] - p[0][1], o[2] - p[0][2] };
+			FLOAT u = ( s[0] * q[0] + s[1] * q[1] + s[2] * q[2] ) * inv;
+			if ( u < 0 || u > 1 ) return;
+			FLOAT r[3]  = { s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0] };
+			FLOAT v = ( d[0] * r[0] + d[1] * r[1] + d[2] * r[2] ) * inv;
+			if ( v < 0 || u + v > 1 ) return;
+			FLOAT dist = ( e2[0] * r[0] + e2[1] * r[1] + e2[2] * r[2] ) * inv;
+			if ( dist >= 0 && dist < nearest )
+			{
+				nearest = dist;
+				hit = t;
+			}
+		};
+
+	// ---- no bvh ?
+		INT number_of_nodes = mesh->GetNumberOfBvhNodes();
+		if ( number_of_nodes == 0 )
+		{
+			for ( INT t = 0; t < number_of_triangles; t++ ) test_triangle(t);
+		}
+
+	// ---- bvh: depth first, nearer child first
+		else
+		{
+			DotObjMesh::BvhNode *node = mesh->GetBvhNodes();
+			INT *bvh_triangle = mesh->GetBvhTriangles();
+			FLOAT inv_d[3] = { 1 / d[0], 1 / d[1], 1 / d[2] };
+
+			//
+			// note: slab test, returning entry distance, or FLT_MAX if
+			// missed or further than the nearest hit so far
+			//
+			auto enter = [&](const DotObjMesh::BvhNode *n)
+			{
+				FLOAT t_min = 0, t_max = nearest;
+				for ( INT a = 0; a < 3; a++ )
+				{
+					FLOAT t0 = ( n->_min[a] - o[a] ) * inv_d[a];
+					FLOAT t1 = ( n->_max[a] - o[a] ) * inv_d[a];
+					if ( t0 > t1 ) { FLOAT t = t0; t0 = t1; t1 = t; }
+					t_min = t0 > t_min ? t0 : t_min;
+					t_max = t1 < t_max ? t1 : t_max;
+					if ( t_min > t_max ) return FLT_MAX;
+				}
+				return t_min;
+			};
+
+			INT stack[PI_DotObjUtilities::DotObjBvhBuild::BVH_STACK_SIZE];
+			INT top = 0;
+			if ( enter(node) < FLT_MAX ) stack[top++] = 0;
+			while ( top > 0 )
+			{
+				DotObjMesh::BvhNode *n = node + stack[--top];
+				if ( n->_count > 0 )
+				{
+					for ( INT i = 0; i < n->_count; i++ )
+						test_triangle(*(bvh_triangle + n->_first + i));
+					continue;
+				}
+				INT   left = (INT)( n - node ) + 1, right = n->_first;
+				FLOAT t_left = enter(node + left), t_right = enter(node + right);
+				if ( t_left > t_right )
+				{
+					INT i = left; left = right; right = i;
+					FLOAT t = t_left; t_left = t_right; t_right = t;
+				}
+				if ( t_right < FLT_MAX ) stack[top++] = right;
+				if ( t_left  < FLT_MAX ) stack[top++] = left;
+			}
+		}
+
+	// ---- hit ?
+		if ( hit < 0 ) return FALSE;
+		if ( distance != NULL ) *distance = nearest;
+		if ( triangle != NULL ) *triangle = hit;
+
+	return TRUE;
+}
+
+
+// ---------- InFrustum ----------
+/*!
+\brief test if any of a flat mesh's bounds is inside a frustum
+\author Gareth Edwards
+\param DotObjMesh *mesh [in]
+\param const FLOAT *plane [in] 6 planes (a, b, c, d), normals pointing in
+\return BOOL FALSE if the bounds are wholly outside any plane (or empty)
+\note conservative, i.e. may be TRUE for bounds just outside a corner
+*/
+BOOL DotObjUtilities::InFrustum(
+		DotObjMesh *mesh,
+		const FLOAT *plane
+	)
+{
+
+	// ---- check
+		if ( mesh == NULL || plane == NULL ) return FALSE;
+		FLOAT min[3], max[3];
+		if ( !mesh->GetBounds(min, max) ) return FALSE;
+
+	// ---- for each plane, test the corner furthest along its normal
+		for ( INT i = 0; i < 6; i++ )
+		{
+			const FLOAT *p = plane + i * 4;
+			FLOAT x = p[0] >= 0 ? max[0] : min[0];
+			FLOAT y = p[1] >= 0 ? max[1] : min[1];
+			FLOAT z = p[2] >= 0 ? max[2] : min[2];
+			if ( p[0] * x + p[1] * y + p[2] * z + p[3] < 0 ) return FALSE;
+		}
+
+	return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- BuildBvhNode ----------
+/*!
+\brief build a bvh node, & recursively its children (see BuildBvh)
+\author Gareth Edwards
+\param DotObjBvhBuild *build [in & out] triangle bounds, centroids & order
+\param std::vector<DotObjMesh::BvhNode> *node [in & out] appended to
+\param INT first [in] of triangles in build->_index
+\param INT count [in] # of triangles
+\param INT depth [in] of node
+*/
+VOID DotObjUtilities::PI_DotObjUtilities::BuildBvhNode
+		(
+			DotObjBvhBuild *build,
+			std::vector<DotObjMesh::BvhNode> *node,
+			INT first,
+			INT count,
+			INT depth
+		)
+{
+
+	// ---- local
+		enum { BINS = DotObjBvhBuild::BVH_BINS };
+		INT   *index    = build->_index.data();
+		FLOAT *box      = build->_box.data();
+		FLOAT *centroid = build->_centroid.data();
+
+	// ---- lambda: surface area (x 0.5) of bounds
+		auto area = [](const FLOAT *min, const FLOAT *max)
+		{
+			FLOAT x = max[0] - min[0], y = max[1] - min[1], z = max[2] - min[2];
+			return x < 0 ? 0 : x * y + y * z + z * x;
+		};
+
+	// ---- node bounds & centroid bounds
+		DotObjMesh::BvhNode n;
+		FLOAT c_min[3] = {  FLT_MAX,  FLT_MAX,  FLT_MAX };
+		FLOAT c_max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		for ( INT a = 0; a < 3; a++ )
+		{
+			n._min[a] =  FLT_MAX;
+			n._max[a] = -FLT_MAX;
+		}
+		for ( INT i = first; i < first + count; i++ )
+		{
+			const FLOAT *b = box + index[i] * 6;
+			const FLOAT *c = centroid + index[i] * 3;
+			for ( INT a = 0; a < 3; a++ )
+			{
+				n._min[a] = b[a]     < n._min[a] ? b[a]     : n._min[a];
+				n._max[a] = b[a + 3] > n._max[a] ? b[a + 3] : n._max[a];
+				c_min[a]  = c[a] < c_min[a] ? c[a] : c_min[a];
+				c_max[a]  = c[a] > c_max[a] ? c[a] : c_max[a];
+			}
+		}
+		n._first = first;
+		n._count = count;
+		INT this_node = (INT)node->size();
+		node->push_back(n);
+
+	// ---- small ?
+		if ( count <= DotObjBvhBuild::BVH_LEAF_SIZE ) return;
+
+	// ---- axis of greatest centroid extent
+		INT axis = 0;
+		for ( INT a = 1; a < 3; a++ )
+			if ( c_max[a] - c_min[a] > c_max[axis] - c_min[axis] ) axis = a;
+		FLOAT extent = c_max[axis] - c_min[axis];
+		if ( extent <= 0 ) return;
+		FLOAT scale = BINS / extent;
+		auto bin_of = [&](INT t)
+		{
+			INT b = (INT)( ( centroid[t * 3 + axis] - c_min[axis] ) * scale );
+			return b < 0 ? 0 : ( b >= BINS ? BINS - 1 : b );
+		};
+
+	// ---- bin triangle counts & bounds
+		INT   bin_count[BINS] = { 0 };
+		FLOAT bin_min[BINS][3], bin_max[BINS][3];
+		for ( INT b = 0; b < BINS; b++ )
+			for ( INT a = 0; a < 3; a++ )
+			{
+				bin_min[b][a] =  FLT_MAX;
+				bin_max[b][a] = -FLT_MAX;
+			}
+		for ( INT i = first; i < first + count; i++ )
+		{
+			INT t = index[i];
+			INT b = bin_of(t);
+			const FLOAT *tb = box + t * 6;
+			bin_count[b]++;
+			for ( INT a = 0; a < 3; a++ )
+			{
+				bin_min[b][a] = tb[a]     < bin_min[b][a] ? tb[a]     : bin_min[b][a];
+				bin_max[b][a] = tb[a + 3] > bin_max[b][a] ? tb[a + 3] : bin_max[b][a];
+			}
+		}
+
+	// ---- SAH cost of a split after each bin (left sweep, then right sweep)
+		FLOAT cost[BINS - 1];
+		{
+			FLOAT min[3] = {  FLT_MAX,  FLT_MAX,  FLT_MAX };
+			FLOAT max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+			INT sum = 0;
+			for ( INT b = 0; b < BINS - 1; b++ )
+			{
+				for ( INT a = 0; a < 3; a++ )
+				{
+					min[a] = bin_min[b][a] < min[a] ? bin_min[b][a] : min[a];
+					max[a] = bin_max[b][a] > max[a] ? bin_max[b][a] : max[a];
+				}
+				sum += bin_count[b];
+				cost[b] = sum * area(min, max);
+			}
+		}
+		{
+			FLOAT min[3] = {  FLT_MAX,  FLT_MAX,  FLT_MAX };
+			FLOAT max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+			INT sum = 0;
+			for ( INT b = BINS - 1; b > 0; b-- )
+			{
+				for ( INT a = 0; a < 3; a++ )
+				{
+					min[a] = bin_min[b][a] < min[a] ? bin_min[b][a] : min[a];
+					max[a] = bin_max[b][a] > max[a] ? bin_max[b][a] : max[a];
+				}
+				sum += bin_count[b];
+				cost[b - 1] += sum * area(min, max);
+			}
+		}
+
+	// ---- best split (leaf if NOT cheaper, unless too big for a leaf)
+		INT split = 0;
+		for ( INT b = 1; b < BINS - 1; b++ )
+			if ( cost[b] < cost[split] ) split = b;
+		FLOAT leaf_cost = count * area(n._min, n._max);
+		if ( cost[split] >= leaf_cost && count <= DotObjBvhBuild::BVH_MAX_LEAF_SIZE ) return;
+
+	// ---- partition (at the median if too deep, see BVH_MAX_DEPTH)
+		INT *middle = depth >= DotObjBvhBuild::BVH_MAX_DEPTH ? index + first :
+			std::partition(
+					index + first,
+					index + first + count,
+					[&](INT t) { return bin_of(t) <= split; }
+				);
+		INT left_count = (INT)( middle - ( index + first ) );
+		if ( left_count == 0 || left_count == count )
+		{
+			left_count = count / 2;
+			std::nth_element(
+					index + first,
+					index + first + left_count,
+					index + first + count,
+					[&](INT a, INT b) { return centroid[a * 3 + axis] < centroid[b * 3 + axis]; }
+				);
+		}
+		INT right_first = first + left_count;
+		INT right_count = count - left_count;
+		( *node )[this_node]._count = 0;
+
+	// ---- children: right on another thread, if big & near the root
+		if ( depth < build->_parallel_depth && count >= DotObjBvhBuild::BVH_PARALLEL_SIZE )
+		{
+			std::vector<DotObjMesh::BvhNode> right_node;
+			right_node.reserve(right_count / DotObjBvhBuild::BVH_LEAF_SIZE * 2 + 1);
+			std::thread right(
+					&PI_DotObjUtilities::BuildBvhNode, this,
+					build, &right_node, right_first, right_count, depth + 1
+				);
+			BuildBvhNode(build, node, first, left_count, depth + 1);
+			right.join();
+
+			INT offset = (INT)node->size();
+			for ( auto &r : right_node )
+				if ( r._count == 0 ) r._first += offset;
+			node->insert(node->end(), right_node.begin(), right_node.end());
+			( *node )[this_node]._first = offset;
+		}
+		else
+		{
+			BuildBvhNode(build, node, first, left_count, depth + 1);
+			( *node )[this_node]._first = (INT)node->size();
+			BuildBvhNode(build, node, right_first, right_count, depth + 1);
+		}
+
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- BenchmarkBvh ----------
+/*!
+\brief time bvh build & ray casts, against every triangle ray casts
+\author Gareth Edwards
+\param INT number_of_faces [in] approximate # of triangles in a synthetic grid
+\param INT number_of_rays [in]
+\return HRESULT (SUCCESS_OK if every bvh hit is the same as without)
+\note the grid is made bumpy, so rays hit at varying heights
+*/
+HRESULT DotObjUtilities::BenchmarkBvh(
+		INT number_of_faces,
+		INT number_of_rays
+	)
+{
+
+	// ---- local
+		using namespace std::chrono;
+		PI_DotObjUtilities *pi = pi_dot_obj_utilities;
+
+	// ---- mesh
+		DotObjMesh mesh;
+		{
+			std::string data;
+			pi->CreateGridData(&data, number_of_faces, TRUE);
+			if ( ParseView(&mesh, data.data(), (INT64)data.size()) != SUCCESS_OK ) return SUCCESS_FAULT;
+		}
+
+	// ---- build
+		auto start = high_resolution_clock::now();
+		ComputeBounds(&mesh);
+		HRESULT hr = BuildBvh(&mesh);
+		DOUBLE build_ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - start).count();
+		if ( hr != SUCCESS_OK ) return SUCCESS_FAULT;
+
+	// ---- tell
+		CHAR msg[256];
+		sprintf_s(msg, 256, "BenchmarkBvh: %d triangles, %d nodes\n", mesh.GetNumberOfTriangles(), mesh.GetNumberOfBvhNodes());
+		OutputDebugString(msg);
+		sprintf_s(msg, 256, "   build      - %9.1f ms\n", build_ms);
+		OutputDebugString(msg);
+
+	// ---- rays, down onto the grid from random points above it
+		std::vector<FLOAT> origin(number_of_rays * 3);
+		srand(1);
+		for ( INT r = 0; r < number_of_rays; r++ )
+		{
+			origin[r * 3 + 0] = (FLOAT)rand() / RAND_MAX - 0.5f;
+			origin[r * 3 + 1] = 1;
+			origin[r * 3 + 2] = (FLOAT)rand() / RAND_MAX - 0.5f;
+		}
+		FLOAT direction[3] = { 0.1f, -1, 0.05f };
+
+	// ---- cast, with bvh
+		std::vector<INT> bvh_hit(number_of_rays);
+		start = high_resolution_clock::now();
+		for ( INT r = 0; r < number_of_rays; r++ )
+		{
+			FLOAT distance;
+			if ( !RayCast(&mesh, &origin[r * 3], direction, &distance, &bvh_hit[r]) ) bvh_hit[r] = -1;
+		}
+		DOUBLE bvh_ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - start).count();
+
+	// ---- cast, every triangle (at most 1000 rays, as O(rays x triangles))
+		INT number_of_checked = number_of_rays < 1000 ? number_of_rays : 1000;
+		DotObjMesh::BvhNode *node = mesh.GetBvhNodes();
+		INT *bvh_triangle = mesh.GetBvhTriangles();
+		INT number_of_nodes = mesh.GetNumberOfBvhNodes();
+		std::vector<DotObjMesh::BvhNode> saved_node(node, node + number_of_nodes);
+		std::vector<INT> saved_triangle(bvh_triangle, bvh_triangle + mesh.GetNumberOfTriangles());
+		mesh.ResizeBvh(0, 0);
+		INT number_of_different = 0;
+		start = high_resolution_clock::now();
+		for ( INT r = 0; r < number_of_checked; r++ )
+		{
+			FLOAT distance;
+			INT hit = -1;
+			if ( !RayCast(&mesh, &origin[r * 3], direction, &distance, &hit) ) hit = -1;
+			if ( hit != bvh_hit[r] ) number_of_different++;
+		}
+		DOUBLE all_ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - start).count();
+		mesh.ResizeBvh(number_of_nodes, mesh.GetNumberOfTriangles());
+		memcpy(mesh.GetBvhNodes(), saved_node.data(), number_of_nodes * sizeof(DotObjMesh::BvhNode));
+		memcpy(mesh.GetBvhTriangles(), saved_triangle.data(), saved_triangle.size() * sizeof(INT));
+
+	// ---- tell
+		DOUBLE bvh_us = bvh_ms * 1000 / ( number_of_rays > 0 ? number_of_rays : 1 );
+		DOUBLE all_us = all_ms * 1000 / ( number_of_checked > 0 ? number_of_checked : 1 );
+		sprintf_s(msg, 256, "   bvh        - %9.3f us per ray (%d rays)\n", bvh_us, number_of_rays);
+		OutputDebugString(msg);
+		sprintf_s(msg, 256, "   every tri  - %9.3f us per ray (%d rays) %.0fx - %d different %s\n",
+				all_us,
+				number_of_checked,
+				all_us / ( bvh_us > 0 ? bvh_us : 1 ),
+				number_of_different,
+				number_of_different == 0 ? "" : "(FAULT)"
+			);
+		OutputDebugString(msg);
+
+	return number_of_different == 0 ? SUCCESS_OK : SUCCESS_FAULT;
+}
@@ -0,0 +1,336 @@
+////////////////////////////////////////////////////////////////////////////////
+
+// ---------- vsl_gfx_dotobj_cache.hpp ----------
+/*!
+\file vsl_gfx_dotobj_cache.hpp
+\brief DotObjUtilities binary cache sidecar methods
+\author Gareth Edwards
+
+\note
+
+With cache mode on, Read(DotObjMesh *) writes a binary sidecar, named
+"<filename>.vsm", after a successful parse, and on later reads maps it
+instead of parsing when it is newer than (and was made from a file of
+the same size as) the ".obj" file.
+
+Sidecar layout:
+
+   DotObjCacheHeader - magic "VSOM", version, header size, # of
+                       positions, texcoords, normals, faces, corners
+                       & triangles, size of source ".obj" and
+                       checksum of arrays
+
+   FLOAT positions[# positions * 3]
+   FLOAT texcoords[# texcoords * 2]
+   FLOAT normals  [# normals   * 3]
+   INT   faces    [# faces     + 1]
+   INT   corners  [# corners   * 3]
+   INT   triangles[# triangles * 3]
+
+i.e. exactly the DotObjMesh arrays, so a warm read is a map, a checksum
+and a copy per array. A sidecar that fails any check is ignored, and
+replaced after the ".obj" file is parsed.
+
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- mesh io cache ----------
+
+BOOL DotObjUtilities::GetCacheMode()
+{
+	return pi_dot_obj_utilities->_cache_mode;
+}
+
+VOID DotObjUtilities::SetCacheMode(BOOL cache_mode)
+{
+	pi_dot_obj_utilities->_cache_mode = cache_mode;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- GetCacheFilename ----------
+/*!
+\brief get the path/file name of a ".obj" file's binary cache sidecar
+\author Gareth Edwards
+\param std::string *cache_filename [out]
+\param CHAR *filename [in] ".obj" path/file name
+*/
+VOID DotObjUtilities::PI_DotObjUtilities::GetCacheFilename
+		(
+			std::string *cache_filename, // [out]
+			CHAR *filename               // [in]
+		)
+{
+	cache_filename->assign(filename);
+	cache_filename->append(".vsm");
+}
+
+
+// ---------- Checksum ----------
+/*!
+\brief accumulate a 64 bit FNV-1a style checksum, one 32 bit word at a time
+\author Gareth Edwards
+\param UINT64 hash [in] running checksum
+\param const VOID *data [in]
+\param INT64 size [in] # of bytes (a multiple of 4)
+\return UINT64 checksum
+*/
+UINT64 DotObjUtilities::PI_DotObjUtilities::Checksum
+		(
+			UINT64 hash,         // [in]
+			const VOID *data,    // [in]
+			INT64 size           // [in]
+		)
+{
+	const UINT *word = (const UINT *)data;
+	INT64 number_of_words = size / 4;
+	for ( INT64 i = 0; i < number_of_words; i++ )
+	{
+		hash ^= *(word + i);
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+
+// ---------- ReadCache ----------
+/*!
+\brief read a flat mesh from a ".obj" file's binary cache sidecar
+\author Gareth Edwards
+\param DotObjMesh *mesh [out]
+\param CHAR *filename [in] ".obj" path/file name
+\return HRESULT (SUCCESS_OK if ok, SUCCESS_FAULT if missing, stale or invalid)
+*/
+HRESULT DotObjUtilities::PI_DotObjUtilities::ReadCache
+		(
+			DotObjMesh *mesh,    // [out]
+			CHAR *filename       // [in]
+		)
+{
+
+	// ---- source time & size
+		HANDLE source = CreateFile(
+				filename,
+				GENERIC_READ,
+				FILE_SHARE_READ,
+				NULL,
+				OPEN_EXISTING,
+				FILE_ATTRIBUTE_NORMAL,
+				NULL
+			);
+		if ( source == INVALID_HANDLE_VALUE ) return SUCCESS_FAULT;
+		FILETIME source_time;
+		LARGE_INTEGER source_size;
+		BOOL ok = GetFileTime(source, NULL, NULL, &source_time) &&
+			GetFileSizeEx(source, &source_size);
+		CloseHandle(source);
+		if ( !ok ) return SUCCESS_FAULT;
+
+	// ---- map sidecar
+		std::string cache_filename;
+		GetCacheFilename(&cache_filename, filename);
+		DotObjView view;
+		if ( MapView(&view, (CHAR *)cache_filename.c_str()) != SUCCESS_OK ) return SUCCESS_FAULT;
+
+	// ---- check & copy
+		HRESULT result = SUCCESS_OK;
+		try
+		{
+
+			// ---- newer than source ?
+				FILETIME cache_time;
+				if ( !GetFileTime(view._file, NULL, NULL, &cache_time) ) throw("time");
+				if ( CompareFileTime(&cache_time, &source_time) <= 0 ) throw("stale");
+
+			// ---- header
+				const DotObjCacheHeader *header = (const DotObjCacheHeader *)view._data;
+				if ( view._size < (INT64)sizeof(DotObjCacheHeader) ) throw("size");
+				if ( memcmp(header->_magic, "VSOM", 4) != 0 ) throw("magic");
+				if ( header->_version != DotObjCacheHeader::VERSION ) throw("version");
+				if ( header->_header_size != sizeof(DotObjCacheHeader) ) throw("header");
+				if ( header->_source_size != source_size.QuadPart ) throw("source");
+
+			// ---- array sizes
+				const INT *count = header->_count;
+				for ( INT i = 0; i < DotObjCursor::COUNT_SIZE; i++ )
+					if ( count[i] < 0 ) throw("count");
+				if ( header->_number_of_triangles < 0 ) throw("count");
+				INT64 bytes[DotObjCursor::COUNT_SIZE + 1] =
+				{
+					(INT64)count[DotObjCursor::POSITIONS] * 3 * (INT64)sizeof(FLOAT),
+					(INT64)count[DotObjCursor::TEXCOORDS] * 2 * (INT64)sizeof(FLOAT),
+					(INT64)count[DotObjCursor::NORMALS]   * 3 * (INT64)sizeof(FLOAT),
+					((INT64)count[DotObjCursor::FACES] + 1) * (INT64)sizeof(INT),
+					(INT64)count[DotObjCursor::CORNERS]   * 3 * (INT64)sizeof(INT),
+					(INT64)header->_number_of_triangles   * 3 * (INT64)sizeof(INT)
+				};
+				INT64 total = sizeof(DotObjCacheHeader);
+				for ( INT i = 0; i < DotObjCursor::COUNT_SIZE + 1; i++ ) total += bytes[i];
+				if ( total != view._size ) throw("size");
+
+			// ---- checksum
+				const CHAR *arrays = view._data + sizeof(DotObjCacheHeader);
+				if ( Checksum(14695981039346656037ULL, arrays, total - sizeof(DotObjCacheHeader)) != header->_checksum )
+					throw("checksum");
+
+			// ---- copy
+				mesh->Resize(
+						count[DotObjCursor::POSITIONS],
+						count[DotObjCursor::TEXCOORDS],
+						count[DotObjCursor::NORMALS],
+						count[DotObjCursor::FACES],
+						count[DotObjCursor::CORNERS]
+					);
+				mesh->ResizeTriangles(header->_number_of_triangles);
+				VOID *array[DotObjCursor::COUNT_SIZE + 1] =
+				{
+					mesh->GetPositions(),
+					mesh->GetTexcoords(),
+					mesh->GetNormals(),
+					mesh->GetFaces(),
+					mesh->GetCorners(),
+					mesh->GetTriangles()
+				};
+				for ( INT i = 0; i < DotObjCursor::COUNT_SIZE + 1; i++ )
+				{
+					if ( bytes[i] > 0 ) memcpy(array[i], arrays, (size_t)bytes[i]);
+					arrays += bytes[i];
+				}
+
+		}
+		catch ( const CHAR *reason )
+		{
+			if ( strcmp(reason, "stale") != 0 )
+			{
+				OutputDebugString("ReadCache: Ignored invalid sidecar (");
+				OutputDebugString(reason);
+				OutputDebugString(") ");
+				OutputDebugString((LPSTR)cache_filename.c_str());
+				OutputDebugString("\n");
+			}
+			result = SUCCESS_FAULT;
+		}
+		UnmapView(&view);
+
+	return result;
+}
+
+
+// ---------- WriteCache ----------
+/*!
+\brief write a flat mesh to a ".obj" file's binary cache sidecar
+\author Gareth Edwards
+\param DotObjMesh *mesh [in]
+\param CHAR *filename [in] ".obj" path/file name
+\return HRESULT (SUCCESS_OK if ok)
+*/
+HRESULT DotObjUtilities::PI_DotObjUtilities::WriteCache
+		(
+			DotObjMesh *mesh,    // [in]
+			CHAR *filename       // [in]
+		)
+{
+
+	// ---- source size
+		HANDLE source = CreateFile(
+				filename,
+				GENERIC_READ,
+				FILE_SHARE_READ,
+				NULL,
+				OPEN_EXISTING,
+				FILE_ATTRIBUTE_NORMAL,
+				NULL
+			);
+		if ( source == INVALID_HANDLE_VALUE ) return SUCCESS_FAULT;
+		LARGE_INTEGER source_size;
+		BOOL ok = GetFileSizeEx(source, &source_size);
+		CloseHandle(source);
+		if ( !ok ) return SUCCESS_FAULT;
+
+	// ---- arrays
+		const VOID *array[DotObjCursor::COUNT_SIZE + 1] =
+		{
+			mesh->GetPositions(),
+			mesh->GetTexcoords(),
+			mesh->GetNormals(),
+			mesh->GetFaces(),
+			mesh->GetCorners(),
+			mesh->GetTriangles()
+		};
+		INT64 bytes[DotObjCursor::COUNT_SIZE + 1] =
+		{
+			(INT64)mesh->GetNumberOfPositions() * 3 * (INT64)sizeof(FLOAT),
+			(INT64)mesh->GetNumberOfTexcoords() * 2 * (INT64)sizeof(FLOAT),
+			(INT64)mesh->GetNumberOfNormals()   * 3 * (INT64)sizeof(FLOAT),
+			((INT64)mesh->GetNumberOfFaces() + 1) * (INT64)sizeof(INT),
+			(INT64)mesh->GetNumberOfCorners()   * 3 * (INT64)sizeof(INT),
+			(INT64)mesh->GetNumberOfTriangles() * 3 * (INT64)sizeof(INT)
+		};
+
+	// ---- header
+		DotObjCacheHeader header;
+		memcpy(header._magic, "VSOM", 4);
+		header._version     = DotObjCacheHeader::VERSION;
+		header._header_size = sizeof(DotObjCacheHeader);
+		header._count[DotObjCursor::POSITIONS] = mesh->GetNumberOfPositions();
+		header._count[DotObjCursor::TEXCOORDS] = mesh->GetNumberOfTexcoords();
+		header._count[DotObjCursor::NORMALS]   = mesh->GetNumberOfNormals();
+		header._count[DotObjCursor::FACES]     = mesh->GetNumberOfFaces();
+		header._count[DotObjCursor::CORNERS]   = mesh->GetNumberOfCorners();
+		header._number_of_triangles = mesh->GetNumberOfTriangles();
+		header._source_size = source_size.QuadPart;
+		header._checksum    = 14695981039346656037ULL;
+		for ( INT i = 0; i < DotObjCursor::COUNT_SIZE + 1; i++ )
+			header._checksum = Checksum(header._checksum, array[i], bytes[i]);
+
+	// ---- create
+		std::string cache_filename;
+		GetCacheFilename(&cache_filename, filename);
+		HANDLE file = CreateFile(
+				cache_filename.c_str(),
+				GENERIC_WRITE,
+				0,
+				NULL,
+				CREATE_ALWAYS,
+				FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+				NULL
+			);
+		if ( file == INVALID_HANDLE_VALUE ) return SUCCESS_FAULT;
+
+	// ---- lambda: write, in blocks that fit a DWORD
+		auto write = [&](const VOID *data, INT64 size)
+		{
+			const CHAR *c = (const CHAR *)data;
+			while ( size > 0 )
+			{
+				DWORD block = (DWORD)( size < (1 << 30) ? size : (1 << 30) );
+				DWORD written = 0;
+				if ( !WriteFile(file, c, block, &written, NULL) || written != block ) return FALSE;
+				c += block;
+				size -= block;
+			}
+			return TRUE;
+		};
+
+	// ---- write
+		ok = write(&header, sizeof(DotObjCacheHeader));
+		for ( INT i = 0; i < DotObjCursor::COUNT_SIZE + 1 && ok; i++ )
+			ok = write(array[i], bytes[i]);
+		CloseHandle(file);
+
+	// ---- partial sidecars would only fail their checksum, but tidy up
+		if ( !ok )
+		{
+			DeleteFile(cache_filename.c_str());
+			return SUCCESS_FAULT;
+		}
+
+	return SUCCESS_OK;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,285 @@
+////////////////////////////////////////////////////////////////////////////////
+
+// ---------- vsl_gfx_dotobj_indexed.hpp ----------
+/*!
+\file vsl_gfx_dotobj_indexed.hpp
+\brief DotObjUtilities flat mesh unique vertex & index buffer methods
+\author Gareth Edwards
+
+\note
+
+GetTriangleVertexBuffer writes one vertex per triangle corner, so a
+vertex shared by n triangles is written n times. The indexed path
+instead writes each unique (v, vt, vn) corner triple once, plus a
+32 bit (UINT, as per Gfx_Kandinsky::GetIndexBuffer) triangle index
+buffer, e.g.:
+
+	dot_obj_utilities.GenerateNormals(mesh, DotObjUtilities::NormalMode::AREA_WEIGHTED, 180); // optional
+	INT number_of_vertices = dot_obj_utilities.CreateUniqueVertices(mesh);
+	INT number_of_indices  = dot_obj_utilities.GetNumberOfTriangles(mesh) * 3;
+	kandinsky->SetVertexBufferSize(number_of_vertices * vertex_size);
+	kandinsky->SetIndexBufferSize(number_of_indices);
+	...
+	dot_obj_utilities.GetIndexedVertexBuffer(mesh, param, vertex_buffer, number_of_vertices, format);
+	dot_obj_utilities.GetTriangleIndexBuffer(mesh, index_buffer, number_of_indices);
+
+Unique vertices are found with an open addressing hash table of the
+corner triples, and stored in the mesh, so they are created once.
+
+A corner with no vn is first given the normal of its face, in the mesh,
+by GenerateNormals, exactly as per GetTriangleVertexBuffer, so buffers
+are the same whichever is got first. As a vertex shared by faces with
+face normals is one unique vertex per face, call GenerateNormals
+beforehand, as above, for smooth normals.
+
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- mesh get indexed buffers ----------
+
+
+// ---------- CreateUniqueVertices ----------
+/*!
+\brief create the unique (v, vt, vn) vertices of a flat mesh
+\author Gareth Edwards
+\param DotObjMesh *mesh [in & out]
+\return INT # of unique vertices
+\note generates face normals for corners with no vn (see GenerateNormals)
+*/
+INT DotObjUtilities::CreateUniqueVertices(DotObjMesh *mesh)
+{
+
+	// ---- check
+		if ( mesh == NULL ) return 0;
+
+	// ---- normals (a bad index is reported when buffers are got)
+		GenerateNormals(mesh, NormalMode::FACE, 0);
+
+	// ---- local
+		INT  number_of_corners = mesh->GetNumberOfCorners();
+		INT *corner = mesh->GetCorners();
+
+	// ---- hash table, at most half full
+		UINT table_size = 16;
+		while ( table_size < (UINT)number_of_corners * 2 ) table_size <<= 1;
+		UINT table_mask = table_size - 1;
+		std::vector<INT> table(table_size, -1);
+
+	// ---- worst case, every corner is unique
+		mesh->ResizeUnique(number_of_corners);
+		INT *unique        = mesh->GetUniqueVertices();
+		INT *corner_vertex = mesh->GetCornerVertices();
+
+	// ---- for each corner
+		INT number_of_unique = 0;
+		for ( INT c = 0; c < number_of_corners; c++ )
+		{
+
+			// ---- hash
+				INT *key = corner + c * 3;
+				UINT hash = (UINT)*(key + 0) * 73856093u ^
+					(UINT)*(key + 1) * 19349663u ^
+						(UINT)*(key + 2) * 83492791u;
+				hash ^= hash >> 16;
+
+			// ---- probe
+				for ( UINT slot = hash & table_mask; ; slot = (slot + 1) & table_mask )
+				{
+					INT u = table[slot];
+					if ( u < 0 )
+					{
+						table[slot] = number_of_unique;
+						unique[number_of_unique] = c;
+						corner_vertex[c] = number_of_unique++;
+						break;
+					}
+					INT *other = corner + unique[u] * 3;
+					if ( *(other + 0) == *(key + 0) &&
+							*(other + 1) == *(key + 1) &&
+								*(other + 2) == *(key + 2) )
+					{
+						corner_vertex[c] = u;
+						break;
+					}
+				}
+
+		}
+
+	// ---- trim
+		mesh->ResizeUnique(number_of_unique);
+
+	return number_of_unique;
+}
+
+
+// ---------- GetIndexedVertexBuffer ----------
+/*!
+\brief get flat mesh unique vertex buffer
+\author Gareth Edwards
+\param DotObjMesh *mesh [in]
+\param FLOAT *object_param [in] scale, width, height, depth, x, y & z offset
+\param FLOAT *vertex_buffer [in & out] vertices buffer
+\param INT vertex_total [in] # of vertices
+\param INT vertex_format [in] vertex format
+\return VS_ERROR <= INT else SUCCESS_OK, etc...
+\note creates unique vertices (& so any missing normals) if not already created
+*/
+INT DotObjUtilities::GetIndexedVertexBuffer(
+		DotObjMesh *mesh,
+		FLOAT *object_param,
+		FLOAT *vertex_buffer,
+		INT vertex_total,
+		INT vertex_format
+	)
+{
+
+	// ---- a lot can go wrong!
+		try
+		{
+
+			// ---- check mesh
+				if ( mesh == NULL )                      throw("mesh: NULL");
+				if ( mesh->GetNumberOfFaces() == 0 )     throw("face element list: empty");
+				if ( mesh->GetNumberOfPositions() == 0 ) throw("geometry element list: empty");
+
+			// ---- check buffer
+				if ( vertex_buffer == NULL )             throw("vertex buffer: NULL");
+
+			// ---- check only for required buffer formats
+				if ( ! ( vertex_format & VS_XYZ)    )    throw("vertex format: NO VS_XYZ");
+				if ( ! ( vertex_format & VS_NORMAL) )    throw("vertex format: VS_NORMAL");
+
+			// ---- unique vertices
+				if ( mesh->GetNumberOfUniqueVertices() == 0 ) CreateUniqueVertices(mesh);
+				INT number_of_unique = mesh->GetNumberOfUniqueVertices();
+				if ( number_of_unique > vertex_total )   throw("vertex buffer: overflow");
+
+			// --- param
+				FLOAT  scale  = object_param[0];
+				FLOAT  width  = object_param[1] * scale;
+				FLOAT  height = object_param[2] * scale;
+				FLOAT  depth  = object_param[3] * scale;
+				FLOAT  x_off  = object_param[4];
+				FLOAT  y_off  = object_param[5];
+				FLOAT  z_off  = object_param[6];
+
+			// ---- arrays
+				FLOAT *position = mesh->GetPositions();
+				FLOAT *normal   = mesh->GetNormals();
+				FLOAT *texcoord = mesh->GetTexcoords();
+				INT   *corner   = mesh->GetCorners();
+				INT   *unique   = mesh->GetUniqueVertices();
+				INT    number_of_positions = mesh->GetNumberOfPositions();
+				INT    number_of_normals   = mesh->GetNumberOfNormals();
+				INT    number_of_texcoords = mesh->GetNumberOfTexcoords();
+
+			// ---- check geometry & normal indices
+				for ( INT u = 0; u < number_of_unique; u++ )
+				{
+					INT *c = corner + unique[u] * 3;
+					if ( c[0] < 0 || c[0] >= number_of_positions ) throw("face element: geometry index out of range");
+					if ( c[2] < 0 || c[2] >= number_of_normals )   throw("face element: normal index out of range");
+				}
+
+			// ---- local
+				BOOL   texture = vertex_format & VS_TEX1 ? TRUE : FALSE;
+				INT    stride  = texture ? 8 : 6;
+				FLOAT *vb = vertex_buffer;
+
+			// ---- for each unique vertex
+				for ( INT u = 0; u < number_of_unique; u++ )
+				{
+					INT *c = corner + unique[u] * 3;
+
+					// ---- geometry
+						FLOAT *p = position + c[0] * 3;
+						*(vb + 0) = *(p + 0) * width  + x_off;
+						*(vb + 1) = *(p + 1) * height + y_off;
+						*(vb + 2) = *(p + 2) * depth  + z_off;
+
+					// ---- normal
+						FLOAT *pn = normal + c[2] * 3;
+						*(vb + 3) = *(pn + 0);
+						*(vb + 4) = *(pn + 1);
+						*(vb + 5) = *(pn + 2);
+
+					// ---- texture
+						if ( texture )
+						{
+							BOOL exists = c[1] >= 0 && c[1] < number_of_texcoords;
+							*(vb + 6) = exists ? *(texcoord + c[1] * 2 + 0) : 0;
+							*(vb + 7) = exists ? *(texcoord + c[1] * 2 + 1) : 0;
+						}
+
+					vb += stride;
+				}
+
+		}
+		catch (CHAR * msg)
+		{
+			OutputDebugString(msg);
+			OutputDebugString("\n");
+			return SUCCESS_FAULT;
+		}
+
+	return SUCCESS_OK;
+}
+
+
+// ---------- GetTriangleIndexBuffer ----------
+/*!
+\brief get flat mesh triangle index buffer (of unique vertices)
+\author Gareth Edwards
+\param DotObjMesh *mesh [in]
+\param UINT *index_buffer [in & out] indices buffer
+\param INT index_total [in] # of indices (GetNumberOfTriangles * 3)
+\return VS_ERROR <= INT else SUCCESS_OK, etc...
+\note triangulates & creates unique vertices if not already done
+\note triangles are as per GetTriangleVertexBuffer
+*/
+INT DotObjUtilities::GetTriangleIndexBuffer(
+		DotObjMesh *mesh,
+		UINT *index_buffer,
+		INT index_total
+	)
+{
+
+	// ---- a lot can go wrong!
+		try
+		{
+
+			// ---- check mesh
+				if ( mesh == NULL )                      throw("mesh: NULL");
+				if ( mesh->GetNumberOfFaces() == 0 )     throw("face element list: empty");
+
+			// ---- check buffer
+				if ( index_buffer == NULL )              throw("index buffer: NULL");
+				INT number_of_triangles = GetNumberOfTriangles(mesh);
+				if ( number_of_triangles * 3 > index_total ) throw("index buffer: overflow");
+
+			// ---- triangulated & unique vertices ?
+				if ( mesh->GetNumberOfTriangles() != number_of_triangles )
+					if ( Triangulate(mesh) != SUCCESS_OK ) throw("face element: geometry index out of range");
+				if ( mesh->GetNumberOfUniqueVertices() == 0 ) CreateUniqueVertices(mesh);
+
+			// ---- unique vertex of each triangle corner
+				INT *triangle      = mesh->GetTriangles();
+				INT *corner_vertex = mesh->GetCornerVertices();
+				for ( INT i = 0; i < number_of_triangles * 3; i++ )
+					*(index_buffer + i) = (UINT)*(corner_vertex + *(triangle + i));
+
+		}
+		catch (CHAR * msg)
+		{
+			OutputDebugString(msg);
+			OutputDebugString("\n");
+			return SUCCESS_FAULT;
+		}
+
+	return SUCCESS_OK;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
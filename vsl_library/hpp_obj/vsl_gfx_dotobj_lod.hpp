@@ -0,0 +1,534 @@
+////////////////////////////////////////////////////////////////////////////////
+
+// ---------- vsl_gfx_dotobj_lod.hpp ----------
+/*!
+\file vsl_gfx_dotobj_lod.hpp
+\brief DotObjUtilities flat mesh level of detail (LOD) methods
+\author Gareth Edwards
+
+\note
+
+GenerateLods makes a chain of simplified triangle lists of a flat mesh's
+unique vertices, so every LOD shares the full detail vertex buffer (see
+GetIndexedVertexBuffer) and only needs an index buffer of its own (see
+GetLodIndexBuffer).
+
+It is a quadric error metric (QEM) simplifier, collapsing one unique
+vertex onto a neighbour (a "half edge" collapse, so no new vertices):
+
+   1. a quadric per vertex, the area weighted sum of the squared
+      distance to the planes of its triangles
+
+   2. vertices on a border (an edge of only one triangle) or a seam
+      (a position shared by unique vertices with different texcoords
+      or normals) are locked, i.e. never collapsed, only onto
+
+   3. each vertex's cheapest collapse is queued, and collapses are
+      taken cheapest first, where a collapse that would flip a
+      triangle is replaced by the vertex's cheapest collapse that would
+      not, and after a collapse the vertex collapsed onto gains the
+      quadric of the one removed, & it (and any neighbour whose
+      cheapest collapse was onto either vertex, or that had none that
+      would not flip) queues its new cheapest collapse
+
+   4. when the # of triangles reaches each LOD's target, a copy of the
+      triangles left is kept, so LOD n + 1 is a simplification of LOD n
+
+Each LOD also keeps its error, the greatest distance (in position units)
+of any collapse made so far, so a caller can pick a LOD by how big that
+error would be on screen.
+
+LOD 0 is the full detail mesh. LOD 1 to N are GetNumberOfLods.
+
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- mesh levels of detail ----------
+
+
+// ---------- GenerateLods ----------
+/*!
+\brief generate a chain of simplified LODs of a flat mesh
+\author Gareth Edwards
+\param DotObjMesh *mesh [in & out]
+\param INT number_of_lods [in] excluding full detail (LOD 0)
+\param const FLOAT *ratio [in] target # of triangles of each LOD, as a
+fraction of full detail (e.g. 0.5, 0.25, ...), or NULL to halve each LOD
+\return HRESULT (SUCCESS_OK if ok)
+\note triangulates & creates unique vertices if not already done
+\note a LOD that cannot reach its target (all locked, or every collapse
+would flip a triangle) keeps as few triangles as it can
+*/
+HRESULT DotObjUtilities::GenerateLods(
+		DotObjMesh *mesh,
+		INT number_of_lods,
+		const FLOAT *ratio
+	)
+{
+
+	// ---- check
+		if ( mesh == NULL || number_of_lods < 0 ) return SUCCESS_FAULT;
+
+	// ---- triangulated & unique vertices ?
+		INT number_of_triangles = GetNumberOfTriangles(mesh);
+		if ( mesh->GetNumberOfTriangles() != number_of_triangles )
+			if ( Triangulate(mesh) != SUCCESS_OK ) return SUCCESS_FAULT;
+		if ( mesh->GetNumberOfUniqueVertices() == 0 ) CreateUniqueVertices(mesh);
+		mesh->ResizeLods(0, 0);
+		if ( number_of_lods == 0 || number_of_triangles == 0 ) return SUCCESS_OK;
+
+	// ---- local
+		INT   *triangle      = mesh->GetTriangles();
+		INT   *corner        = mesh->GetCorners();
+		INT   *unique        = mesh->GetUniqueVertices();
+		INT   *corner_vertex = mesh->GetCornerVertices();
+		FLOAT *position      = mesh->GetPositions();
+		INT    number_of_unique    = mesh->GetNumberOfUniqueVertices();
+		INT    number_of_positions = mesh->GetNumberOfPositions();
+
+	// ---- position of each unique vertex
+		std::vector<INT> position_of(number_of_unique);
+		for ( INT u = 0; u < number_of_unique; u++ )
+		{
+			INT v = *(corner + *(unique + u) * 3);
+			if ( v < 0 || v >= number_of_positions ) return SUCCESS_FAULT;
+			position_of[u] = v;
+		}
+
+	// ---- unique vertex of each triangle corner
+		std::vector<INT> index(number_of_triangles * 3);
+		for ( INT i = 0; i < number_of_triangles * 3; i++ )
+			index[i] = *(corner_vertex + *(triangle + i));
+
+	// ---- target # of triangles of each LOD
+		std::vector<INT> target(number_of_lods);
+		FLOAT fraction = 1;
+		for ( INT l = 0; l < number_of_lods; l++ )
+		{
+			fraction = ratio == NULL ? fraction * 0.5f : ratio[l];
+			target[l] = (INT)( number_of_triangles * fraction );
+		}
+
+	// ---- simplify
+		std::vector<INT>   lod_index;
+		std::vector<INT>   lod_first;
+		std::vector<FLOAT> lod_error;
+		pi_dot_obj_utilities->SimplifyChain(
+				position,
+				position_of.data(),
+				number_of_unique,
+				index.data(),
+				number_of_triangles,
+				number_of_lods,
+				target.data(),
+				&lod_index,
+				&lod_first,
+				&lod_error
+			);
+
+	// ---- store
+		mesh->ResizeLods(number_of_lods, (INT)lod_index.size());
+		memcpy(mesh->GetLodFirst(),   lod_first.data(), lod_first.size() * sizeof(INT));
+		memcpy(mesh->GetLodIndices(), lod_index.data(), lod_index.size() * sizeof(INT));
+		memcpy(mesh->GetLodErrors(),  lod_error.data(), lod_error.size() * sizeof(FLOAT));
+
+	return SUCCESS_OK;
+}
+
+
+// ---------- GetLodNumberOfTriangles ----------
+/*!
+\brief get # of triangles of a flat mesh LOD
+\author Gareth Edwards
+\param DotObjMesh *mesh [in]
+\param INT lod [in] 0 (full detail) to GetNumberOfLods
+\return INT # of triangles (0 if no such LOD)
+*/
+INT DotObjUtilities::GetLodNumberOfTriangles(
+		DotObjMesh *mesh,
+		INT lod
+	)
+{
+	if ( mesh == NULL || lod < 0 || lod > mesh->GetNumberOfLods() ) return 0;
+	if ( lod == 0 ) return GetNumberOfTriangles(mesh);
+	INT *first = mesh->GetLodFirst();
+	return ( *(first + lod) - *(first + lod - 1) ) / 3;
+}
+
+
+// ---------- GetLodIndexBuffer ----------
+/*!
+\brief get flat mesh LOD triangle index buffer (of unique vertices)
+\author Gareth Edwards
+\param DotObjMesh *mesh [in]
+\param INT lod [in] 0 (full detail) to GetNumberOfLods
+\param UINT *index_buffer [in & out] indices buffer
+\param INT index_total [in] # of indices (GetLodNumberOfTriangles * 3)
+\return VS_ERROR <= INT else SUCCESS_OK, etc...
+\note LOD 0 is as per GetTriangleIndexBuffer; all LODs index the
+vertices of GetIndexedVertexBuffer
+*/
+INT DotObjUtilities::GetLodIndexBuffer(
+		DotObjMesh *mesh,
+		INT lod,
+		UINT *index_buffer,
+		INT index_total
+	)
+{
+
+	// ---- full detail ?
+		if ( lod == 0 ) return GetTriangleIndexBuffer(mesh, index_buffer, index_total);
+
+	// ---- a lot can go wrong!
+		try
+		{
+
+			// ---- check
+				if ( mesh == NULL )                                  throw("mesh: NULL");
+				if ( lod < 0 || lod > mesh->GetNumberOfLods() )      throw("lod: out of range");
+				if ( index_buffer == NULL )                          throw("index buffer: NULL");
+
+			// ---- copy
+				INT *first = mesh->GetLodFirst();
+				INT  number_of_indices = *(first + lod) - *(first + lod - 1);
+				if ( number_of_indices > index_total )               throw("index buffer: overflow");
+				INT *index = mesh->GetLodIndices() + *(first + lod - 1);
+				for ( INT i = 0; i < number_of_indices; i++ )
+					*(index_buffer + i) = (UINT)*(index + i);
+
+		}
+		catch (CHAR * msg)
+		{
+			OutputDebugString(msg);
+			OutputDebugString("\n");
+			return SUCCESS_FAULT;
+		}
+
+	return SUCCESS_OK;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- SimplifyChain ----------
+/*!
+\brief QEM simplify a triangle list, keeping a copy at each target
+\author Gareth Edwards
+\param const FLOAT *position [in] xyz of each position
+\param const INT *position_of [in] position of each vertex
+\param INT number_of_vertices [in]
+\param const INT *index [in] 3 vertices per triangle
+\param INT number_of_triangles [in]
+\param INT number_of_lods [in]
+\param const INT *target [in] # of triangles of each LOD
+\param std::vector<INT> *lod_index [out] 3 vertices per triangle, each LOD in turn
+\param std::vector<INT> *lod_first [out] first index of each LOD, # of LODs + 1
+\param std::vector<FLOAT> *lod_error [out] of each LOD
+*/
+VOID DotObjUtilities::PI_DotObjUtilities::SimplifyChain
+		(
+			const FLOAT *position,
+			const INT *position_of,
+			INT number_of_vertices,
+			const INT *index,
+			INT number_of_triangles,
+			INT number_of_lods,
+			const INT *target,
+			std::vector<INT> *lod_index,
+			std::vector<INT> *lod_first,
+			std::vector<FLOAT> *lod_error
+		)
+{
+
+	// ---- local
+		INT V = number_of_vertices;
+		INT T = number_of_triangles;
+		std::vector<INT> tri(index, index + T * 3);
+		std::vector<BYTE> tri_dead(T, 0);
+		auto p_of = [&](INT v) { return position + position_of[v] * 3; };
+
+	// ---- 1. quadrics (area weighted planes, & sum of weights)
+		struct Quadric { DOUBLE q[11]; };
+		std::vector<Quadric> quadric(V);
+		memset(quadric.data(), 0, V * sizeof(Quadric));
+		for ( INT t = 0; t < T; t++ )
+		{
+			const FLOAT *p0 = p_of(tri[t * 3]), *p1 = p_of(tri[t * 3 + 1]), *p2 = p_of(tri[t * 3 + 2]);
+			DOUBLE e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+			DOUBLE e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+			DOUBLE n[3]  = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+			DOUBLE len   = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+			if ( len <= 0 ) continue;
+			DOUBLE a = n[0] / len, b = n[1] / len, c = n[2] / len;
+			DOUBLE d = -( a * p0[0] + b * p0[1] + c * p0[2] );
+			DOUBLE w = len * 0.5;
+			DOUBLE plane[11] = { a*a, a*b, a*c, a*d, b*b, b*c, b*d, c*c, c*d, d*d, 1 };
+			for ( INT i = 0; i < 3; i++ )
+			{
+				DOUBLE *q = quadric[tri[t * 3 + i]].q;
+				for ( INT k = 0; k < 11; k++ ) q[k] += plane[k] * w;
+			}
+		}
+
+	// ---- lambda: weighted sum of squared distances of a point from the planes of a quadric
+		auto distance = [](const Quadric &Q, const FLOAT *p)
+		{
+			const DOUBLE *q = Q.q;
+			DOUBLE x = p[0], y = p[1], z = p[2];
+			return
+				q[0] * x * x + 2 * q[1] * x * y + 2 * q[2] * x * z + 2 * q[3] * x +
+				q[4] * y * y + 2 * q[5] * y * z + 2 * q[6] * y +
+				q[7] * z * z + 2 * q[8] * z +
+				q[9];
+		};
+
+	// ---- lambda: mean squared distance of a point from the planes of two quadrics
+		auto error = [&](const Quadric &A, const Quadric &B, const FLOAT *p)
+		{
+			DOUBLE e = distance(A, p) + distance(B, p);
+			DOUBLE w = A.q[10] + B.q[10];
+			return (FLOAT)( w > 0 ? ( e > 0 ? e : 0 ) / w : 0 );
+		};
+
+	// ---- 2. lock seam & border vertices
+		std::vector<BYTE> locked(V, 0);
+		{
+			std::vector<INT> vertices_at;
+			INT max_position = 0;
+			for ( INT v = 0; v < V; v++ ) max_position = position_of[v] > max_position ? position_of[v] : max_position;
+			vertices_at.assign(max_position + 1, 0);
+			for ( INT v = 0; v < V; v++ ) vertices_at[position_of[v]]++;
+			for ( INT v = 0; v < V; v++ ) if ( vertices_at[position_of[v]] > 1 ) locked[v] = 1;
+
+			std::vector<UINT64> edge(T * 3);
+			for ( INT t = 0; t < T; t++ )
+				for ( INT i = 0; i < 3; i++ )
+				{
+					UINT64 a = (UINT)tri[t * 3 + i], b = (UINT)tri[t * 3 + ( i + 1 ) % 3];
+					edge[t * 3 + i] = a < b ? ( a << 32 ) | b : ( b << 32 ) | a;
+				}
+			std::sort(edge.begin(), edge.end());
+			for ( size_t i = 0; i < edge.size(); )
+			{
+				size_t j = i + 1;
+				while ( j < edge.size() && edge[j] == edge[i] ) j++;
+				if ( j - i == 1 )
+				{
+					locked[(INT)( edge[i] >> 32 )] = 1;
+					locked[(INT)( edge[i] & 0xFFFFFFFF )] = 1;
+				}
+				i = j;
+			}
+		}
+
+	// ---- triangles of each vertex
+		std::vector<std::vector<INT>> tri_of(V);
+		for ( INT t = 0; t < T; t++ )
+			for ( INT i = 0; i < 3; i++ )
+				tri_of[tri[t * 3 + i]].push_back(t);
+
+	// ---- lambda: would collapsing from onto flip (or degenerate) a triangle ?
+		auto flips = [&](INT from, INT onto)
+		{
+			const FLOAT *pf = p_of(from), *po = p_of(onto);
+			for ( INT t : tri_of[from] )
+			{
+				if ( tri_dead[t] ) continue;
+				INT *v = &tri[t * 3];
+				if ( v[0] == onto || v[1] == onto || v[2] == onto ) continue;
+				INT k = v[0] == from ? 0 : ( v[1] == from ? 1 : 2 );
+				const FLOAT *p1 = p_of(v[( k + 1 ) % 3]), *p2 = p_of(v[( k + 2 ) % 3]);
+				FLOAT a1[3] = { p1[0] - pf[0], p1[1] - pf[1], p1[2] - pf[2] };
+				FLOAT a2[3] = { p2[0] - pf[0], p2[1] - pf[1], p2[2] - pf[2] };
+				FLOAT b1[3] = { p1[0] - po[0], p1[1] - po[1], p1[2] - po[2] };
+				FLOAT b2[3] = { p2[0] - po[0], p2[1] - po[1], p2[2] - po[2] };
+				FLOAT na[3] = { a1[1] * a2[2] - a1[2] * a2[1], a1[2] * a2[0] - a1[0] * a2[2], a1[0] * a2[1] - a1[1] * a2[0] };
+				FLOAT nb[3] = { b1[1] * b2[2] - b1[2] * b2[1], b1[2] * b2[0] - b1[0] * b2[2], b1[0] * b2[1] - b1[1] * b2[0] };
+				FLOAT dot = na[0] * nb[0] + na[1] * nb[1] + na[2] * nb[2];
+				FLOAT la  = na[0] * na[0] + na[1] * na[1] + na[2] * na[2];
+				FLOAT lb  = nb[0] * nb[0] + nb[1] * nb[1] + nb[2] * nb[2];
+				if ( dot <= 0.25f * sqrt(la * lb) ) return TRUE;
+			}
+			return FALSE;
+		};
+
+	// ---- 3. cheapest collapse of each vertex, cheapest first (stale if a stamp changed)
+		struct Candidate
+		{
+			FLOAT cost;
+			INT   from, onto;
+			UINT  from_stamp, onto_stamp;
+			BOOL operator<(const Candidate &c) const { return cost > c.cost; }
+		};
+		std::vector<Candidate> heap;
+		heap.reserve(V * 2);
+		std::vector<UINT> stamp(V, 0);
+		std::vector<BYTE> vertex_dead(V, 0);
+		std::vector<INT>  best(V, -1);
+		auto push = [&](INT from, BOOL no_flip)
+		{
+			if ( locked[from] || vertex_dead[from] ) return;
+			FLOAT cost = FLT_MAX;
+			INT   onto = -1;
+			for ( INT t : tri_of[from] )
+			{
+				if ( tri_dead[t] ) continue;
+				for ( INT i = 0; i < 3; i++ )
+				{
+					INT x = tri[t * 3 + i];
+					if ( x == from || x == onto ) continue;
+					FLOAT e = error(quadric[from], quadric[x], p_of(x));
+					if ( e < cost && !( no_flip && flips(from, x) ) )
+					{
+						cost = e;
+						onto = x;
+					}
+				}
+			}
+			best[from] = onto;
+			if ( onto < 0 ) return;
+			heap.push_back({ cost, from, onto, stamp[from], stamp[onto] });
+			std::push_heap(heap.begin(), heap.end());
+		};
+		for ( INT v = 0; v < V; v++ ) push(v, FALSE);
+
+	// ---- 4. collapse, keeping a copy of the triangles at each target
+		std::vector<INT> merged;
+		INT   live = T;
+		FLOAT max_error = 0;
+		lod_index->clear();
+		lod_first->assign(1, 0);
+		lod_error->clear();
+		for ( INT l = 0; l < number_of_lods; l++ )
+		{
+			while ( live > target[l] && !heap.empty() )
+			{
+				std::pop_heap(heap.begin(), heap.end());
+				Candidate c = heap.back();
+				heap.pop_back();
+				if ( vertex_dead[c.from] || vertex_dead[c.onto] ) continue;
+				if ( stamp[c.from] != c.from_stamp || stamp[c.onto] != c.onto_stamp ) continue;
+
+				// ---- flips ? then queue the cheapest collapse that does NOT
+				//      (if none, best is -1, so it is queued again when its
+				//      one ring changes)
+					if ( flips(c.from, c.onto) )
+					{
+						push(c.from, TRUE);
+						continue;
+					}
+
+				// ---- collapse
+					merged.clear();
+					for ( INT t : tri_of[c.onto] ) if ( !tri_dead[t] ) merged.push_back(t);
+					for ( INT t : tri_of[c.from] )
+					{
+						if ( tri_dead[t] ) continue;
+						INT *v = &tri[t * 3];
+						if ( v[0] == c.onto || v[1] == c.onto || v[2] == c.onto )
+						{
+							tri_dead[t] = 1;
+							live--;
+							continue;
+						}
+						for ( INT i = 0; i < 3; i++ ) if ( v[i] == c.from ) v[i] = c.onto;
+						merged.push_back(t);
+					}
+					for ( INT k = 0; k < 11; k++ ) quadric[c.onto].q[k] += quadric[c.from].q[k];
+					vertex_dead[c.from] = 1;
+					tri_of[c.from].clear();
+					tri_of[c.from].shrink_to_fit();
+					merged.erase(
+							std::remove_if(merged.begin(), merged.end(), [&](INT t) { return tri_dead[t] != 0; }),
+							merged.end()
+						);
+					tri_of[c.onto].swap(merged);
+					stamp[c.onto]++;
+					max_error = c.cost > max_error ? c.cost : max_error;
+
+				// ---- new cheapest collapse of the vertex collapsed onto, & of
+				//      neighbours whose cheapest was onto either vertex, or
+				//      that had none that did NOT flip
+					push(c.onto, FALSE);
+					for ( INT t : tri_of[c.onto] )
+						for ( INT i = 0; i < 3; i++ )
+						{
+							INT x = tri[t * 3 + i];
+							if ( x != c.onto && ( best[x] == c.onto || best[x] == c.from || best[x] < 0 ) )
+								push(x, FALSE);
+						}
+			}
+
+			// ---- keep
+				for ( INT t = 0; t < T; t++ )
+					if ( !tri_dead[t] )
+						lod_index->insert(lod_index->end(), &tri[t * 3], &tri[t * 3] + 3);
+				lod_first->push_back((INT)lod_index->size());
+				lod_error->push_back(sqrt(max_error));
+		}
+
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- BenchmarkLods ----------
+/*!
+\brief time LOD generation, & report triangles & error of each LOD
+\author Gareth Edwards
+\param INT number_of_faces [in] approximate # of triangles in a synthetic grid
+\param INT number_of_lods [in] each half of the one before
+\return HRESULT (SUCCESS_OK if ok)
+\note the grid is made bumpy, so collapses have a cost
+*/
+HRESULT DotObjUtilities::BenchmarkLods(
+		INT number_of_faces,
+		INT number_of_lods
+	)
+{
+
+	// ---- local
+		using namespace std::chrono;
+		PI_DotObjUtilities *pi = pi_dot_obj_utilities;
+
+	// ---- mesh
+		DotObjMesh mesh;
+		{
+			std::string data;
+			pi->CreateGridData(&data, number_of_faces, TRUE);
+			if ( ParseView(&mesh, data.data(), (INT64)data.size()) != SUCCESS_OK ) return SUCCESS_FAULT;
+		}
+		CreateUniqueVertices(&mesh);
+
+	// ---- generate
+		auto start = high_resolution_clock::now();
+		HRESULT hr = GenerateLods(&mesh, number_of_lods, NULL);
+		DOUBLE ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - start).count();
+
+	// ---- tell
+		CHAR msg[256];
+		sprintf_s(msg, 256, "BenchmarkLods: %d triangles, %d vertices - %.1f ms %s\n",
+				mesh.GetNumberOfTriangles(),
+				mesh.GetNumberOfUniqueVertices(),
+				ms,
+				hr == SUCCESS_OK ? "" : "(FAULT)"
+			);
+		OutputDebugString(msg);
+		for ( INT l = 0; l <= mesh.GetNumberOfLods(); l++ )
+		{
+			INT number_of_triangles = GetLodNumberOfTriangles(&mesh, l);
+			sprintf_s(msg, 256, "   LOD %2d - %9d triangles %6.2f%% - error %.6f\n",
+					l,
+					number_of_triangles,
+					100.0 * number_of_triangles / mesh.GetNumberOfTriangles(),
+					l == 0 ? 0 : *(mesh.GetLodErrors() + l - 1)
+				);
+			OutputDebugString(msg);
+		}
+
+	return hr;
+}
@@ -0,0 +1,360 @@
+////////////////////////////////////////////////////////////////////////////////
+
+// ---------- vsl_gfx_dotobj_mapped.hpp ----------
+/*!
+\file vsl_gfx_dotobj_mapped.hpp
+\brief DotObjUtilities memory mapped (zero copy) read methods
+\author Gareth Edwards
+
+\note
+
+In MAPPED read mode the ".obj" file is mapped read only and parsed in
+place, so there is no file sized heap buffer and no Scrub copy. Lines
+and words are handled as pointer + length views into the mapping and
+are never written to or terminated.
+
+A census pass over the view counts the vertex, face and corner lines
+first, so the DotObjMesh arrays are sized once and never regrow; peak
+memory is therefore roughly the size of the resulting mesh.
+
+\note a 32 bit (Win32) build can only map files that fit in the
+process address space; use the x64 build for multi-gigabyte files.
+
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- MapView ----------
+/*!
+\brief map a file into a read only view
+\author Gareth Edwards
+\param DotObjView *view [out]
+\param CHAR *filename [in]
+\return HRESULT (SUCCESS_OK if ok)
+*/
+HRESULT DotObjUtilities::PI_DotObjUtilities::MapView
+		(
+			DotObjView *view,    // [out]
+			CHAR *filename       // [in]
+		)
+{
+
+	// ---- open
+		view->_file = CreateFile(
+				filename,
+				GENERIC_READ,
+				FILE_SHARE_READ,
+				NULL,
+				OPEN_EXISTING,
+				FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+				NULL
+			);
+		if ( view->_file == INVALID_HANDLE_VALUE ) return SUCCESS_FAULT;
+
+	// ---- size
+		LARGE_INTEGER size;
+		if ( !GetFileSizeEx(view->_file, &size) || size.QuadPart == 0 )
+		{
+			UnmapView(view);
+			return SUCCESS_FAULT;
+		}
+		view->_size = size.QuadPart;
+
+	// ---- map
+		view->_mapping = CreateFileMapping(view->_file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if ( view->_mapping == NULL )
+		{
+			UnmapView(view);
+			return SUCCESS_FAULT;
+		}
+		view->_data = (const CHAR *)MapViewOfFile(view->_mapping, FILE_MAP_READ, 0, 0, 0);
+		if ( view->_data == NULL )
+		{
+			UnmapView(view);
+			return SUCCESS_FAULT;
+		}
+
+	return SUCCESS_OK;
+}
+
+
+// ---------- UnmapView ----------
+/*!
+\brief unmap & close a read only view
+\author Gareth Edwards
+\param DotObjView *view [in & out]
+*/
+VOID DotObjUtilities::PI_DotObjUtilities::UnmapView
+		(
+			DotObjView *view     // [in & out]
+		)
+{
+	if ( view->_data != NULL )
+	{
+		UnmapViewOfFile(view->_data);
+		view->_data = NULL;
+	}
+	if ( view->_mapping != NULL )
+	{
+		CloseHandle(view->_mapping);
+		view->_mapping = NULL;
+	}
+	if ( view->_file != INVALID_HANDLE_VALUE )
+	{
+		CloseHandle(view->_file);
+		view->_file = INVALID_HANDLE_VALUE;
+	}
+	view->_size = 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- mesh io mode ----------
+
+DotObjUtilities::ReadMode DotObjUtilities::GetReadMode()
+{
+	return pi_dot_obj_utilities->_read_mode;
+}
+
+VOID DotObjUtilities::SetReadMode(ReadMode mode)
+{
+	pi_dot_obj_utilities->_read_mode = mode;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- ClassifyLine ----------
+/*!
+\brief classify a read only ".obj" format line by its tag word
+\author Gareth Edwards
+\param const CHAR **c [in & out] start of line, returned as first char after tag
+\param const CHAR *end [in] end of line (excluding '\n')
+\return DotObjElement::TagId (UNDEFINED if blank or not a known tag)
+\note shared by CensusChunk and ParseChunk so both always agree
+*/
+DotObjElement::TagId DotObjUtilities::PI_DotObjUtilities::ClassifyLine
+		(
+			const CHAR **c,      // [in & out]
+			const CHAR *end      // [in]
+		)
+{
+
+	// ---- tag word
+		const CHAR *p = *c;
+		while ( p < end && ( *p == ' ' || *p == '\t' || *p == '\r' ) ) p++;
+		const CHAR *tag = p;
+		while ( p < end && *p != ' ' && *p != '\t' && *p != '\r' ) p++;
+		INT len = (INT)(p - tag);
+		*c = p;
+
+	return GetTagId(tag, len);
+}
+
+
+// ---------- CensusChunk ----------
+/*!
+\brief count the lines & face corners in a read only ".obj" chunk
+\author Gareth Edwards
+\param const CHAR *data [in] first char of chunk
+\param const CHAR *end [in] end of chunk
+\param INT *count [out] # of positions, texcoords, normals, faces & corners
+*/
+VOID DotObjUtilities::PI_DotObjUtilities::CensusChunk
+		(
+			const CHAR *data,    // [in]
+			const CHAR *end,     // [in]
+			INT *count           // [out]
+		)
+{
+
+	// ---- zero
+		for ( INT i = 0; i < DotObjCursor::COUNT_SIZE; i++ ) count[i] = 0;
+
+	// ---- for each line
+		for ( const CHAR *line = data; line < end; )
+		{
+			const CHAR *eol = (const CHAR *)memchr(line, '\n', (size_t)(end - line));
+			if ( eol == NULL ) eol = end;
+
+			const CHAR *c = line;
+			switch ( ClassifyLine(&c, eol) )
+			{
+				case DotObjElement::TagId::VERTEX_GEOMETRY: count[DotObjCursor::POSITIONS]++; break;
+				case DotObjElement::TagId::VERTEX_TEXTURE:  count[DotObjCursor::TEXCOORDS]++; break;
+				case DotObjElement::TagId::VERTEX_NORMAL:   count[DotObjCursor::NORMALS]++;   break;
+				case DotObjElement::TagId::ELEMENT_FACE:
+					{
+						count[DotObjCursor::FACES]++;
+						CHAR last_c = ' ';
+						for ( ; c < eol; c++ )
+						{
+							BOOL space = *c == ' ' || *c == '\t' || *c == '\r';
+							if ( !space && last_c == ' ' ) count[DotObjCursor::CORNERS]++;
+							last_c = space ? ' ' : *c;
+						}
+					}
+					break;
+				default:
+					break;
+			}
+
+			line = eol + 1;
+		}
+
+}
+
+
+// ---------- ParseChunk ----------
+/*!
+\brief parse a read only ".obj" chunk into presized flat mesh arrays
+\author Gareth Edwards
+\param DotObjCursor *cursor [in & out] where (and how much) to write
+\param const CHAR *data [in] first char of chunk (NOT written to or terminated)
+\param const CHAR *end [in] end of chunk
+\return HRESULT (SUCCESS_OK if ok)
+
+\note
+
+Positive ".obj" indices are absolute, so are simply made 0 based.
+
+Negative (relative) indices are resolved against the # of vertices
+preceding the line, which is the cursor's base (# in all previous
+chunks) plus the # already written by this chunk.
+
+*/
+HRESULT DotObjUtilities::PI_DotObjUtilities::ParseChunk
+		(
+			DotObjCursor *cursor, // [in & out]
+			const CHAR *data,     // [in]
+			const CHAR *end       // [in]
+		)
+{
+
+	// ---- local
+		INT *count = cursor->_count;
+		INT *total = cursor->_total;
+		INT *base  = cursor->_base;
+
+	// ---- lambda: skip white space (returns FALSE at end of line)
+		const CHAR *c = data;
+		const CHAR *eol = data;
+		auto skip_space = [&]()
+		{
+			while ( c < eol && ( *c == ' ' || *c == '\t' || *c == '\r' ) ) c++;
+			return c < eol;
+		};
+
+	// ---- lambda: skip rest of word (e.g. junk after a number)
+		auto skip_word = [&]()
+		{
+			while ( c < eol && *c != ' ' && *c != '\t' && *c != '\r' ) c++;
+		};
+
+	// ---- lambda: resolve a ".obj" index
+		auto resolve = [&](INT index, INT type)
+		{
+			return index > 0 ? index - 1 :
+				( index < 0 ? base[type] + count[type] + index : -1 );
+		};
+
+	// ---- for each line
+		for ( const CHAR *line = data; line < end; line = eol + 1 )
+		{
+			eol = (const CHAR *)memchr(line, '\n', (size_t)(end - line));
+			if ( eol == NULL ) eol = end;
+
+			c = line;
+			DotObjElement::TagId tag_id = ClassifyLine(&c, eol);
+
+			switch ( tag_id )
+			{
+
+				// ---- vertex
+					case DotObjElement::TagId::VERTEX_GEOMETRY:
+					case DotObjElement::TagId::VERTEX_NORMAL:
+					case DotObjElement::TagId::VERTEX_TEXTURE:
+						{
+							INT type =
+								tag_id == DotObjElement::TagId::VERTEX_GEOMETRY ? DotObjCursor::POSITIONS :
+									( tag_id == DotObjElement::TagId::VERTEX_NORMAL ? DotObjCursor::NORMALS :
+										DotObjCursor::TEXCOORDS );
+							if ( count[type] >= total[type] ) return SUCCESS_FAULT;
+
+							FLOAT v[3] = { 0, 0, 0 };
+							for ( INT w = 0; w < 3 && skip_space(); w++ )
+							{
+								v[w] = ScanFloat(&c, eol);
+								skip_word();
+							}
+
+							switch ( type )
+							{
+								case DotObjCursor::POSITIONS:
+									{
+										FLOAT *p = cursor->_positions + count[type] * 3;
+										*(p + 0) = v[0]; *(p + 1) = v[1]; *(p + 2) = v[2];
+									}
+									break;
+								case DotObjCursor::NORMALS:
+									{
+										FLOAT *p = cursor->_normals + count[type] * 3;
+										*(p + 0) = v[0]; *(p + 1) = v[1]; *(p + 2) = v[2];
+									}
+									break;
+								default:
+									{
+										FLOAT *p = cursor->_texcoords + count[type] * 2;
+										*(p + 0) = v[0]; *(p + 1) = v[1];
+									}
+									break;
+							}
+							count[type]++;
+						}
+						break;
+
+				// ---- face
+					case DotObjElement::TagId::ELEMENT_FACE:
+						{
+							if ( count[DotObjCursor::FACES] >= total[DotObjCursor::FACES] ) return SUCCESS_FAULT;
+							*(cursor->_faces + count[DotObjCursor::FACES]++) =
+								cursor->_corner_base + count[DotObjCursor::CORNERS];
+
+							while ( skip_space() )
+							{
+								if ( count[DotObjCursor::CORNERS] >= total[DotObjCursor::CORNERS] ) return SUCCESS_FAULT;
+
+								// ---- "v", "v/vt", "v//vn" or "v/vt/vn", scanned in place
+									INT index[3] = { 0, 0, 0 };
+									for ( INT i = 0; i < 3; i++ )
+									{
+										if ( c < eol && *c != '/' ) index[i] = ScanInt(&c, eol);
+										if ( c < eol && *c == '/' ) c++; else break;
+									}
+									skip_word();
+
+								// ---- add
+									INT *corner = cursor->_corners + count[DotObjCursor::CORNERS]++ * 3;
+									*(corner + 0) = resolve(index[0], DotObjCursor::POSITIONS);
+									*(corner + 1) = resolve(index[1], DotObjCursor::TEXCOORDS);
+									*(corner + 2) = resolve(index[2], DotObjCursor::NORMALS);
+							}
+						}
+						break;
+
+				// ---- not stored in a flat mesh
+					default:
+						break;
+			}
+
+		}
+
+	return SUCCESS_OK;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
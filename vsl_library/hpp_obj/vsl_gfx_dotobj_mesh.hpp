@@ -0,0 +1,373 @@
+////////////////////////////////////////////////////////////////////////////////
+
+// ---------- vsl_gfx_dotobj_mesh.hpp ----------
+/*!
+\file vsl_gfx_dotobj_mesh.hpp
+\brief DotObjUtilities flat (DotObjMesh) read & buffer methods
+\author Gareth Edwards
+
+\note
+
+A DotObjMesh stores each attribute in a contiguous array, so reading
+fills a handful of vectors and buffer extraction is a linear scan,
+rather than a walk over a DotObjElement node per value.
+
+Both read modes parse via ParseView (see vsl_gfx_dotobj_parallel.hpp).
+
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- mesh io framework ----------
+
+
+// ---------- Read ----------
+/*!
+\brief read a ".obj" format object data file into a flat mesh
+\author Gareth Edwards
+\param DotObjMesh *mesh [in]
+\param CHAR *filename [in]
+\return HRESULT (SUCCESS_OK if ok)
+*/
+HRESULT DotObjUtilities::Read(
+		DotObjMesh *mesh, CHAR *filename
+	)
+{
+
+	// ---- error
+		if ( mesh == NULL ) return SUCCESS_FAULT;
+
+	// ---- cached ?
+		BOOL cached = pi_dot_obj_utilities->_cache_mode &&
+				pi_dot_obj_utilities->ReadCache(mesh, filename) == SUCCESS_OK;
+
+	// ---- mapped ?
+		HRESULT hr = SUCCESS_OK;
+		if ( cached )
+		{
+			;
+		}
+		else if ( pi_dot_obj_utilities->_read_mode == ReadMode::MAPPED )
+		{
+			PI_DotObjUtilities::DotObjView view;
+			hr = pi_dot_obj_utilities->MapView(&view, filename);
+			if ( hr != SUCCESS_OK ) return hr;
+			mesh->Clear();
+			hr = ParseView(mesh, view._data, view._size);
+			pi_dot_obj_utilities->UnmapView(&view);
+		}
+
+	// ---- buffered: read file, then parse as a read only view (no Scrub copy)
+		else
+		{
+			using namespace std;
+			ifstream file(filename, ios::in | ios::binary | ios::ate);
+			if ( !file.is_open() ) return SUCCESS_FAULT;
+
+			file.seekg(0, ios::end);
+			streamoff size = file.tellg();
+			char *data = new char[(int)size + 1];
+			file.seekg(0, ios::beg);
+			file.read(data, size);
+			file.close();
+
+			mesh->Clear();
+			hr = ParseView(mesh, data, (INT64)size);
+			delete[] data;
+		}
+
+	// ---- cache for next time (failure is not an error)
+		if ( hr == SUCCESS_OK && pi_dot_obj_utilities->_cache_mode && !cached )
+			pi_dot_obj_utilities->WriteCache(mesh, filename);
+
+	// ---- bounds, & bvh if bvh mode (see vsl_gfx_dotobj_bvh.hpp)
+		if ( hr == SUCCESS_OK )
+		{
+			ComputeBounds(mesh);
+			if ( pi_dot_obj_utilities->_bvh_mode ) hr = BuildBvh(mesh);
+		}
+
+	return hr;
+}
+
+
+// ---------- Report ----------
+/*!
+\brief report on a flat mesh
+\author Gareth Edwards
+\param DotObjMesh *mesh [in]
+\param CHAR *filename [in] ".obj" path/file name
+\return HRESULT (SUCCESS_OK if ok)
+*/
+HRESULT DotObjUtilities::Report(
+		DotObjMesh *mesh,
+		CHAR *filename
+	)
+{
+
+	// ---- check
+		if ( mesh == NULL ) return SUCCESS_FAULT;
+
+	// ---- tell
+		CHAR msg[256];
+		OutputDebugString("Mesh: Path/File - ");
+		OutputDebugString(filename);
+		OutputDebugString("\n");
+		sprintf_s(msg, 256, "   %10d - %s \n", mesh->GetNumberOfPositions(), pi_dot_obj_utilities->GetTagLabel(DotObjElement::TagId::VERTEX_GEOMETRY));
+		OutputDebugString(msg);
+		sprintf_s(msg, 256, "   %10d - %s \n", mesh->GetNumberOfTexcoords(), pi_dot_obj_utilities->GetTagLabel(DotObjElement::TagId::VERTEX_TEXTURE));
+		OutputDebugString(msg);
+		sprintf_s(msg, 256, "   %10d - %s \n", mesh->GetNumberOfNormals(), pi_dot_obj_utilities->GetTagLabel(DotObjElement::TagId::VERTEX_NORMAL));
+		OutputDebugString(msg);
+		sprintf_s(msg, 256, "   %10d - %s \n", mesh->GetNumberOfFaces(), pi_dot_obj_utilities->GetTagLabel(DotObjElement::TagId::ELEMENT_FACE));
+		OutputDebugString(msg);
+		sprintf_s(msg, 256, "   %10d - %s \n", mesh->GetNumberOfCorners(), "face corners");
+		OutputDebugString(msg);
+
+	return SUCCESS_OK;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- mesh get buffers ----------
+
+
+// ---------- GetVertexBuffer ----------
+/*!
+\brief get flat mesh vertex buffer
+\author Gareth Edwards
+\param DotObjMesh *mesh [in]
+\param FLOAT *vertex_buffer [in & out] vertices buffer
+\param INT vertex_count [in] # of vertices
+\param INT vertex_format [in] vertex format
+\return VS_ERROR <= INT else SUCCESS_OK, etc...
+\note see vertex info in GetVertexBuffer(DotObjElement *) method
+*/
+INT DotObjUtilities::GetVertexBuffer(
+		DotObjMesh *mesh,
+		FLOAT *vertex_buffer,
+		INT vertex_count,
+		INT vertex_format
+	)
+{
+
+	// ---- check
+		if ( mesh == NULL || vertex_buffer == NULL ) return SUCCESS_FAULT;
+		INT number_of_vertices = mesh->GetNumberOfPositions();
+		if ( number_of_vertices > vertex_count ) return SUCCESS_FAULT;
+
+	// ---- default diffuse colour
+		union colour_union_t {
+			DWORD d;
+			FLOAT f;
+		} diffuse;
+		diffuse.d = 0xffffffff;
+
+	// ---- flags
+		BOOL normal  = vertex_format & vsl_library::Gfx_Kandinsky_Vertex_Format::NORMAL  ? TRUE : FALSE;
+		BOOL colour  = vertex_format & vsl_library::Gfx_Kandinsky_Vertex_Format::DIFFUSE ? TRUE : FALSE;
+		BOOL texture = vertex_format & vsl_library::Gfx_Kandinsky_Vertex_Format::TEX1    ? TRUE : FALSE;
+
+	// ---- get
+		FLOAT *p  = mesh->GetPositions();
+		FLOAT *vb = vertex_buffer;
+		for ( INT i = 0; i < number_of_vertices; i++ )
+		{
+
+			// ---- geometry
+				*(vb + 0) = *(p++);
+				*(vb + 1) = *(p++);
+				*(vb + 2) = *(p++);
+				vb += 3;
+
+			// ---- vertex normals
+				if ( normal )
+				{
+					*(vb + 0) = 0;
+					*(vb + 1) = 0;
+					*(vb + 2) = 0;
+					vb += 3;
+				}
+
+			// --- diffuse
+				if ( colour )
+				{
+					*(vb++) = diffuse.f;
+				}
+
+			// ---- texture coordinates
+				if ( texture )
+				{
+					*(vb + 0) = 0;
+					*(vb + 1) = 0;
+					vb += 2;
+				}
+
+		}
+
+	return SUCCESS_OK;
+}
+
+
+// ---------- GetNumberOfTriangles ----------
+/*!
+\brief get number of flat mesh triangles
+\author Gareth Edwards
+\param DotObjMesh *mesh [in]
+\return INT #
+*/
+INT DotObjUtilities::GetNumberOfTriangles(DotObjMesh *mesh)
+{
+
+	// ---- check
+		if ( mesh == NULL ) return 0;
+
+	// ---- count
+		INT *face = mesh->GetFaces();
+		INT  number_of_faces = mesh->GetNumberOfFaces();
+		INT  number_of_triangles = 0;
+		for ( INT f = 0; f < number_of_faces; f++ )
+		{
+			INT number_of_indices = face[f + 1] - face[f];
+			number_of_triangles += number_of_indices > 2 ?
+				number_of_indices - 2 : 0;
+		}
+
+	return number_of_triangles;
+}
+
+
+// ---------- GetTriangleVertexBuffer ----------
+/*!
+\brief get flat mesh triangle vertex buffer
+\author Gareth Edwards
+\param DotObjMesh *mesh [in]
+\param FLOAT *object_param [in] scale, width, height, depth, x, y & z offset
+\param FLOAT *vertex_buffer [in & out] vertices buffer
+\param INT vertex_total [in] # of vertices
+\param INT vertex_format [in] vertex format
+\return VS_ERROR <= INT else SUCCESS_OK, etc...
+\note faces are triangulated (see Triangulate) if not already
+\note a corner with no vn is first given the normal of its face, in the
+mesh (see GenerateNormals), so call GenerateNormals beforehand for others
+\note see vertex info in GetVertexBuffer(DotObjElement *) method
+*/
+INT DotObjUtilities::GetTriangleVertexBuffer(
+		DotObjMesh *mesh,
+		FLOAT *object_param,
+		FLOAT *vertex_buffer,
+		INT vertex_total,
+		INT vertex_format
+	)
+{
+
+	// ---- a lot can go wrong!
+		try
+		{
+
+			// ---- check mesh
+				if ( mesh == NULL )                    throw("mesh: NULL");
+				if ( mesh->GetNumberOfFaces() == 0 )   throw("face element list: empty");
+				if ( mesh->GetNumberOfPositions() == 0 ) throw("geometry element list: empty");
+
+			// ---- check buffer
+				if ( vertex_buffer == NULL )           throw("vertex buffer: NULL");
+
+			// ---- check only for required buffer formats
+				if ( ! ( vertex_format & VS_XYZ)    )  throw("vertex format: NO VS_XYZ");
+				if ( ! ( vertex_format & VS_NORMAL) )  throw("vertex format: VS_NORMAL");
+
+			// ---- check size
+				INT number_of_triangles = GetNumberOfTriangles(mesh);
+				if ( number_of_triangles * 3 > vertex_total ) throw("vertex buffer: overflow");
+
+			// ---- triangulated ?
+				if ( mesh->GetNumberOfTriangles() != number_of_triangles )
+					if ( Triangulate(mesh) != SUCCESS_OK ) throw("face element: geometry index out of range");
+
+			// ---- normals ? (as per CreateUniqueVertices, so call order does NOT matter)
+				if ( GenerateNormals(mesh, NormalMode::FACE, 0) != SUCCESS_OK )
+					throw("face element: geometry index out of range");
+
+			// --- param
+				FLOAT  scale  = object_param[0];
+				FLOAT  width  = object_param[1] * scale;
+				FLOAT  height = object_param[2] * scale;
+				FLOAT  depth  = object_param[3] * scale;
+				FLOAT  x_off  = object_param[4];
+				FLOAT  y_off  = object_param[5];
+				FLOAT  z_off  = object_param[6];
+
+			// ---- arrays
+				FLOAT *position = mesh->GetPositions();
+				FLOAT *normal   = mesh->GetNormals();
+				FLOAT *texcoord = mesh->GetTexcoords();
+				INT   *corner   = mesh->GetCorners();
+				INT   *triangle = mesh->GetTriangles();
+				INT    number_of_texcoords = mesh->GetNumberOfTexcoords();
+				INT    number_of_normals   = mesh->GetNumberOfNormals();
+
+			// ---- check normal indices (geometry indices are checked by Triangulate)
+				for ( INT t = 0; t < number_of_triangles * 3; t++ )
+				{
+					INT vn = *(corner + *(triangle + t) * 3 + 2);
+					if ( vn < 0 || vn >= number_of_normals ) throw("face element: normal index out of range");
+				}
+
+			// ---- local
+				BOOL   texture = vertex_format & VS_TEX1 ? TRUE : FALSE;
+				INT    stride  = texture ? 8 : 6;
+				FLOAT *vb = vertex_buffer;
+
+			// ---- lambda: write one corner
+				auto write_corner = [&](INT *c)
+				{
+
+					// ---- geometry
+						FLOAT *p = position + c[0] * 3;
+						*(vb + 0) = *(p + 0) * width  + x_off;
+						*(vb + 1) = *(p + 1) * height + y_off;
+						*(vb + 2) = *(p + 2) * depth  + z_off;
+
+					// ---- normal
+						FLOAT *pn = normal + c[2] * 3;
+						*(vb + 3) = *(pn + 0);
+						*(vb + 4) = *(pn + 1);
+						*(vb + 5) = *(pn + 2);
+
+					// ---- texture
+						if ( texture )
+						{
+							BOOL exists = c[1] >= 0 && c[1] < number_of_texcoords;
+							*(vb + 6) = exists ? *(texcoord + c[1] * 2 + 0) : 0;
+							*(vb + 7) = exists ? *(texcoord + c[1] * 2 + 1) : 0;
+						}
+
+					vb += stride;
+				};
+
+			// ---- for each triangle
+				for ( INT t = 0; t < number_of_triangles; t++ )
+				{
+
+					write_corner(corner + *(triangle + t * 3 + 0) * 3);
+					write_corner(corner + *(triangle + t * 3 + 1) * 3);
+					write_corner(corner + *(triangle + t * 3 + 2) * 3);
+				}
+
+		}
+		catch (CHAR * msg)
+		{
+			OutputDebugString(msg);
+			OutputDebugString("\n");
+			return SUCCESS_FAULT;
+		}
+
+	return SUCCESS_OK;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,471 @@
+////////////////////////////////////////////////////////////////////////////////
+
+// ---------- vsl_gfx_dotobj_normals.hpp ----------
+/*!
+\file vsl_gfx_dotobj_normals.hpp
+\brief DotObjUtilities flat mesh normal generation methods
+\author Gareth Edwards
+
+\note
+
+GenerateNormals gives every face corner that has no vn a generated one,
+appended to the mesh normal array (so buffers, Write & the unique
+vertex hash treat it exactly as a vn read from file):
+
+   FACE           - one normal per face (its Newell normal)
+
+   AREA_WEIGHTED  - one normal per position, per smoothing group: the
+   ANGLE_WEIGHTED   sum of the normals of the faces that share the
+                    position, weighted by face area or by the angle of
+                    the face at the position, where a face only counts
+                    if its normal is within the crease angle of the
+                    corner's own face normal (>= 180 is fully smooth)
+
+It is a separate pass over the flat arrays, in face then position
+ranges (one per thread for big meshes):
+
+   1. face normals (& corner weights), for each face range
+
+   2. position -> corner list, i.e. counting sort of corners by position
+
+   3. corner normals, for each position range, where corners of one
+      position with identical normals share one (so a smooth vertex is
+      still one unique vertex)
+
+   4. exclusive prefix sum of the # of normals made by each range,
+      then each range writes its normals & vn indices in place
+
+so the result is the same for any # of threads.
+
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- mesh normals ----------
+
+
+// ---------- GenerateNormals ----------
+/*!
+\brief generate normals for the face corners of a flat mesh that have no vn
+\author Gareth Edwards
+\param DotObjMesh *mesh [in & out]
+\param NormalMode mode [in] FACE, AREA_WEIGHTED or ANGLE_WEIGHTED
+\param FLOAT crease_angle [in] degrees (ignored for FACE)
+\return HRESULT (SUCCESS_OK if ok, SUCCESS_FAULT if a geometry index is out of range)
+\note corners that already have a vn are left as is; unique vertices,
+if created, are cleared (as vn indices change)
+*/
+HRESULT DotObjUtilities::GenerateNormals(
+		DotObjMesh *mesh,
+		NormalMode mode,
+		FLOAT crease_angle
+	)
+{
+
+	// ---- check
+		if ( mesh == NULL ) return SUCCESS_FAULT;
+
+	// ---- local
+		INT   *face     = mesh->GetFaces();
+		INT   *corner   = mesh->GetCorners();
+		FLOAT *position = mesh->GetPositions();
+		INT    number_of_faces     = mesh->GetNumberOfFaces();
+		INT    number_of_corners   = mesh->GetNumberOfCorners();
+		INT    number_of_positions = mesh->GetNumberOfPositions();
+		INT    number_of_normals   = mesh->GetNumberOfNormals();
+
+	// ---- lambda: does a corner need a normal ?
+		auto missing = [&](INT k)
+		{
+			INT vn = *(corner + k * 3 + 2);
+			return vn < 0 || vn >= number_of_normals;
+		};
+
+	// ---- any ?
+		BOOL any_missing = FALSE;
+		for ( INT k = 0; k < number_of_corners && !any_missing; k++ )
+			any_missing = missing(k);
+		if ( !any_missing ) return SUCCESS_OK;
+
+	// ---- # of threads
+		INT number_of_threads = pi_dot_obj_utilities->_number_of_threads;
+		if ( number_of_threads <= 0 )
+		{
+			number_of_threads = (INT)std::thread::hardware_concurrency();
+			number_of_threads = number_of_threads < 1 ? 1 : number_of_threads;
+		}
+
+	// ---- lambda: # of ranges of items (small counts are NOT split)
+		auto get_number_of_ranges = [number_of_threads](INT number_of_items)
+		{
+			const INT min_items_per_range = 1 << 16;
+			INT number_of_ranges = number_of_items / min_items_per_range;
+			return number_of_ranges < 1 ? 1 :
+				( number_of_ranges > number_of_threads ? number_of_threads : number_of_ranges );
+		};
+
+	// ---- lambda: invoke function(range index) once per range, concurrently if > 1
+		auto for_each_range = [](INT number_of_ranges, auto function)
+		{
+			if ( number_of_ranges == 1 )
+			{
+				function(0);
+				return;
+			}
+			std::vector<std::thread> thread;
+			thread.reserve(number_of_ranges - 1);
+			for ( INT r = 1; r < number_of_ranges; r++ )
+				thread.push_back(std::thread(function, r));
+			function(0);
+			for ( auto &t : thread ) t.join();
+		};
+
+	// ---- lambda: first item of a range
+		auto range_first = [](INT number_of_items, INT number_of_ranges, INT r)
+		{
+			return (INT)( (INT64)number_of_items * r / number_of_ranges );
+		};
+
+	// ---- 1. face normals (unit) & corner weights, for each face range
+		//
+		// note: |Newell normal| is twice the face area, and the angle of
+		// a corner is between the edges to its previous & next corners
+		//
+		std::vector<FLOAT> face_normal(number_of_faces * 3);
+		std::vector<FLOAT> corner_weight(mode == NormalMode::FACE ? 0 : number_of_corners);
+		std::vector<INT>   corner_face(mode == NormalMode::FACE ? 0 : number_of_corners);
+		INT number_of_face_ranges = get_number_of_ranges(number_of_faces);
+		std::vector<HRESULT> result(number_of_face_ranges, SUCCESS_OK);
+		for_each_range(number_of_face_ranges, [&](INT r)
+		{
+			INT first_face = range_first(number_of_faces, number_of_face_ranges, r);
+			INT last_face  = range_first(number_of_faces, number_of_face_ranges, r + 1);
+			for ( INT f = first_face; f < last_face; f++ )
+			{
+
+				// ---- Newell normal
+					FLOAT n[3] = { 0, 0, 0 };
+					for ( INT k = face[f], j = face[f + 1] - 1; k < face[f + 1]; j = k++ )
+					{
+						INT a = *(corner + j * 3), b = *(corner + k * 3);
+						if ( a < 0 || a >= number_of_positions || b < 0 || b >= number_of_positions )
+						{
+							result[r] = SUCCESS_FAULT;
+							return;
+						}
+						const FLOAT *pa = position + a * 3, *pb = position + b * 3;
+						n[0] += ( pa[1] - pb[1] ) * ( pa[2] + pb[2] );
+						n[1] += ( pa[2] - pb[2] ) * ( pa[0] + pb[0] );
+						n[2] += ( pa[0] - pb[0] ) * ( pa[1] + pb[1] );
+					}
+					FLOAT length = (FLOAT)sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+					FLOAT q = length > 0 ? 1 / length : 0;
+					FLOAT *fn = face_normal.data() + f * 3;
+					fn[0] = n[0] * q;
+					fn[1] = n[1] * q;
+					fn[2] = n[2] * q;
+
+				// ---- corner weights
+					if ( mode == NormalMode::FACE ) continue;
+					INT first = face[f], count = face[f + 1] - face[f];
+					for ( INT i = 0; i < count; i++ )
+					{
+						INT k = first + i;
+						corner_face[k] = f;
+						if ( mode == NormalMode::AREA_WEIGHTED )
+						{
+							corner_weight[k] = length * 0.5f;
+							continue;
+						}
+						const FLOAT *p  = position + *(corner + k * 3) * 3;
+						const FLOAT *pp = position + *(corner + ( first + ( i + count - 1 ) % count ) * 3) * 3;
+						const FLOAT *pn = position + *(corner + ( first + ( i + 1 ) % count ) * 3) * 3;
+						FLOAT e0[3] = { pp[0] - p[0], pp[1] - p[1], pp[2] - p[2] };
+						FLOAT e1[3] = { pn[0] - p[0], pn[1] - p[1], pn[2] - p[2] };
+						FLOAT d  = e0[0] * e1[0] + e0[1] * e1[1] + e0[2] * e1[2];
+						FLOAT l  = (FLOAT)sqrt(( e0[0] * e0[0] + e0[1] * e0[1] + e0[2] * e0[2] ) *
+							( e1[0] * e1[0] + e1[1] * e1[1] + e1[2] * e1[2] ));
+						FLOAT c = l > 0 ? d / l : 1;
+						c = c < -1 ? -1 : ( c > 1 ? 1 : c );
+						corner_weight[k] = length > 0 ? (FLOAT)acos(c) : 0;
+					}
+			}
+		});
+		for ( auto hr : result ) if ( hr != SUCCESS_OK ) return hr;
+
+	// ---- FACE: one normal per face with a corner that needs one
+		if ( mode == NormalMode::FACE )
+		{
+
+			// ---- # of faces that need a normal, for each range
+				std::vector<INT> range_base(number_of_face_ranges + 1, 0);
+				for_each_range(number_of_face_ranges, [&](INT r)
+				{
+					INT first_face = range_first(number_of_faces, number_of_face_ranges, r);
+					INT last_face  = range_first(number_of_faces, number_of_face_ranges, r + 1);
+					INT count = 0;
+					for ( INT f = first_face; f < last_face; f++ )
+					{
+						BOOL need = FALSE;
+						for ( INT k = face[f]; k < face[f + 1] && !need; k++ ) need = missing(k);
+						count += need ? 1 : 0;
+					}
+					range_base[r + 1] = count;
+				});
+				for ( INT r = 0; r < number_of_face_ranges; r++ ) range_base[r + 1] += range_base[r];
+
+			// ---- append, & set vn of corners that need one
+				mesh->ResizeNormals(number_of_normals + range_base[number_of_face_ranges]);
+				FLOAT *normal = mesh->GetNormals();
+				for_each_range(number_of_face_ranges, [&](INT r)
+				{
+					INT first_face = range_first(number_of_faces, number_of_face_ranges, r);
+					INT last_face  = range_first(number_of_faces, number_of_face_ranges, r + 1);
+					INT vn = number_of_normals + range_base[r];
+					for ( INT f = first_face; f < last_face; f++ )
+					{
+						BOOL need = FALSE;
+						for ( INT k = face[f]; k < face[f + 1]; k++ )
+						{
+							if ( !missing(k) ) continue;
+							*(corner + k * 3 + 2) = vn;
+							need = TRUE;
+						}
+						if ( !need ) continue;
+						memcpy(normal + vn * 3, face_normal.data() + f * 3, 3 * sizeof(FLOAT));
+						vn++;
+					}
+				});
+
+			mesh->ResizeUnique(0);
+			return SUCCESS_OK;
+		}
+
+	// ---- 2. position -> corner list (counting sort)
+		std::vector<INT> position_first(number_of_positions + 1, 0);
+		std::vector<INT> position_corner(number_of_corners);
+		for ( INT k = 0; k < number_of_corners; k++ )
+			position_first[*(corner + k * 3) + 1]++;
+		for ( INT p = 0; p < number_of_positions; p++ )
+			position_first[p + 1] += position_first[p];
+		{
+			std::vector<INT> next(position_first.begin(), position_first.end() - 1);
+			for ( INT k = 0; k < number_of_corners; k++ )
+				position_corner[next[*(corner + k * 3)]++] = k;
+		}
+
+	// ---- 3. corner normals, for each position range
+		//
+		// note: a corner that needs a normal gets the weighted sum of
+		// the face normals of its position's corners within the crease
+		// angle, & shares the normal of the first such corner of the
+		// same position with an identical sum (share[k], else k)
+		//
+		FLOAT cos_crease = (FLOAT)cos(crease_angle * 3.14159265358979 / 180);
+		BOOL  smooth = crease_angle >= 180;
+		std::vector<FLOAT> corner_normal(number_of_corners * 3, 0);
+		std::vector<INT>   share(number_of_corners, -1);
+		INT number_of_position_ranges = get_number_of_ranges(number_of_positions);
+		std::vector<INT> range_base(number_of_position_ranges + 1, 0);
+		for_each_range(number_of_position_ranges, [&](INT r)
+		{
+			INT first_position = range_first(number_of_positions, number_of_position_ranges, r);
+			INT last_position  = range_first(number_of_positions, number_of_position_ranges, r + 1);
+			INT count = 0;
+			for ( INT p = first_position; p < last_position; p++ )
+			{
+				const INT *list = position_corner.data() + position_first[p];
+				INT list_size = position_first[p + 1] - position_first[p];
+				for ( INT i = 0; i < list_size; i++ )
+				{
+					INT k = list[i];
+					if ( !missing(k) ) continue;
+
+					// ---- sum
+						FLOAT *cn = corner_normal.data() + k * 3;
+						const FLOAT *fk = face_normal.data() + corner_face[k] * 3;
+						for ( INT j = 0; j < list_size; j++ )
+						{
+							INT g = list[j];
+							const FLOAT *fg = face_normal.data() + corner_face[g] * 3;
+							if ( !smooth && fk[0] * fg[0] + fk[1] * fg[1] + fk[2] * fg[2] < cos_crease ) continue;
+							FLOAT w = corner_weight[g];
+							cn[0] += fg[0] * w;
+							cn[1] += fg[1] * w;
+							cn[2] += fg[2] * w;
+						}
+						FLOAT length = (FLOAT)sqrt(cn[0] * cn[0] + cn[1] * cn[1] + cn[2] * cn[2]);
+						if ( length > 0 )
+						{
+							cn[0] /= length; cn[1] /= length; cn[2] /= length;
+						}
+
+					// ---- share ?
+						share[k] = k;
+						for ( INT j = 0; j < i; j++ )
+						{
+							INT s = list[j];
+							if ( share[s] == s && memcmp(corner_normal.data() + s * 3, cn, 3 * sizeof(FLOAT)) == 0 )
+							{
+								share[k] = s;
+								break;
+							}
+						}
+						count += share[k] == k ? 1 : 0;
+
+					// ---- fully smooth: every other corner of this position is the same
+						if ( smooth )
+						{
+							for ( INT j = i + 1; j < list_size; j++ )
+							{
+								INT s = list[j];
+								if ( missing(s) ) share[s] = k;
+							}
+							break;
+						}
+				}
+			}
+			range_base[r + 1] = count;
+		});
+
+	// ---- 4. prefix sum, then append normals & set vn, for each position range
+		for ( INT r = 0; r < number_of_position_ranges; r++ ) range_base[r + 1] += range_base[r];
+		mesh->ResizeNormals(number_of_normals + range_base[number_of_position_ranges]);
+		FLOAT *normal = mesh->GetNormals();
+		for_each_range(number_of_position_ranges, [&](INT r)
+		{
+			INT first_position = range_first(number_of_positions, number_of_position_ranges, r);
+			INT last_position  = range_first(number_of_positions, number_of_position_ranges, r + 1);
+			INT vn = number_of_normals + range_base[r];
+			for ( INT p = first_position; p < last_position; p++ )
+			{
+				for ( INT i = position_first[p]; i < position_first[p + 1]; i++ )
+				{
+					INT k = position_corner[i];
+					INT s = share[k];
+					if ( s < 0 ) continue;
+					if ( s == k )
+					{
+						memcpy(normal + vn * 3, corner_normal.data() + k * 3, 3 * sizeof(FLOAT));
+						*(corner + k * 3 + 2) = vn++;
+					}
+					else
+					{
+						*(corner + k * 3 + 2) = *(corner + s * 3 + 2);
+					}
+				}
+			}
+		});
+
+	mesh->ResizeUnique(0);
+	return SUCCESS_OK;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- benchmark ----------
+
+
+// ---------- BenchmarkNormals ----------
+/*!
+\brief benchmark normal generation for a synthetic grid without vn
+\author Gareth Edwards
+\param INT number_of_faces [in] approximate # of triangles
+\param INT max_threads [in] (<= 0 is one per hardware thread)
+\return HRESULT (SUCCESS_OK if ok, and every thread count made the same normals)
+*/
+HRESULT DotObjUtilities::BenchmarkNormals(
+		INT number_of_faces,
+		INT max_threads
+	)
+{
+
+	// ---- local
+		using namespace std::chrono;
+		PI_DotObjUtilities *pi = pi_dot_obj_utilities;
+		INT number_of_threads = pi->_number_of_threads;
+		if ( max_threads <= 0 )
+		{
+			max_threads = (INT)std::thread::hardware_concurrency();
+			max_threads = max_threads < 1 ? 1 : max_threads;
+		}
+
+	// ---- mesh, without vn
+		DotObjMesh grid;
+		{
+			std::string data;
+			pi->CreateGridData(&data, number_of_faces, FALSE);
+			if ( ParseView(&grid, data.data(), (INT64)data.size()) != SUCCESS_OK ) return SUCCESS_FAULT;
+		}
+		for ( INT k = 0; k < grid.GetNumberOfCorners(); k++ )
+			*(grid.GetCorners() + k * 3 + 2) = -1;
+		grid.ResizeNormals(0);
+
+	// ---- tell
+		CHAR msg[256];
+		sprintf_s(msg, 256, "BenchmarkNormals: %d faces, %d corners\n", grid.GetNumberOfFaces(), grid.GetNumberOfCorners());
+		OutputDebugString(msg);
+
+	// ---- for each mode & # of threads
+		struct { NormalMode mode; FLOAT crease_angle; const CHAR *name; } test[3] =
+		{
+			{ NormalMode::FACE,           0,   "face"        },
+			{ NormalMode::AREA_WEIGHTED,  180, "area"        },
+			{ NormalMode::ANGLE_WEIGHTED, 60,  "angle (60)"  },
+		};
+		HRESULT result = SUCCESS_OK;
+		for ( auto &m : test )
+		{
+			std::vector<FLOAT> one_thread_normals;
+			std::vector<INT>   one_thread_corners;
+			DOUBLE one_thread_ms = 0;
+			for ( INT t = 1; t <= max_threads; t++ )
+			{
+				DotObjMesh mesh;
+				mesh.Resize(grid.GetNumberOfPositions(), 0, 0, grid.GetNumberOfFaces(), grid.GetNumberOfCorners());
+				memcpy(mesh.GetPositions(), grid.GetPositions(), grid.GetNumberOfPositions() * 3 * sizeof(FLOAT));
+				memcpy(mesh.GetFaces(),     grid.GetFaces(),     ( grid.GetNumberOfFaces() + 1 ) * sizeof(INT));
+				memcpy(mesh.GetCorners(),   grid.GetCorners(),   grid.GetNumberOfCorners() * 3 * sizeof(INT));
+				pi->_number_of_threads = t;
+
+				auto start = high_resolution_clock::now();
+				HRESULT hr = GenerateNormals(&mesh, m.mode, m.crease_angle);
+				DOUBLE ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - start).count();
+
+				std::vector<FLOAT> normals(mesh.GetNormals(), mesh.GetNormals() + mesh.GetNumberOfNormals() * 3);
+				std::vector<INT>   corners(mesh.GetCorners(), mesh.GetCorners() + mesh.GetNumberOfCorners() * 3);
+				if ( t == 1 )
+				{
+					one_thread_ms = ms;
+					one_thread_normals.swap(normals);
+					one_thread_corners.swap(corners);
+				}
+				else if ( normals != one_thread_normals || corners != one_thread_corners )
+				{
+					hr = SUCCESS_FAULT;
+				}
+				if ( hr != SUCCESS_OK ) result = SUCCESS_FAULT;
+
+				sprintf_s(msg, 256, "   %-10s %2d threads - %9.1f ms %5.2fx - %d normals %s\n",
+						m.name,
+						t,
+						ms,
+						one_thread_ms / ms,
+						mesh.GetNumberOfNormals(),
+						hr == SUCCESS_OK ? "" : "(FAULT)"
+					);
+				OutputDebugString(msg);
+			}
+		}
+
+	// ---- restore
+		pi->_number_of_threads = number_of_threads;
+
+	return result;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,407 @@
+////////////////////////////////////////////////////////////////////////////////
+
+// ---------- vsl_gfx_dotobj_optimise.hpp ----------
+/*!
+\file vsl_gfx_dotobj_optimise.hpp
+\brief DotObjUtilities flat mesh vertex cache & vertex fetch optimisation methods
+\author Gareth Edwards
+
+\note
+
+Triangles are drawn in the order they were read, so a vertex shared by
+several triangles is often transformed several times, as it has left
+the (small) post transform vertex cache before it is used again.
+
+OptimiseMesh reorders, in two passes:
+
+   vertex cache - the triangles, so that triangles sharing vertices are
+                  drawn close together (Tom Forsyth's "Linear-Speed
+                  Vertex Cache Optimisation", i.e. greedily draw the
+                  triangle whose vertices score highest, where a vertex
+                  scores for being recently used & for having few
+                  triangles left to draw)
+
+   vertex fetch - the unique vertices, into the order the reordered
+                  triangles first use them, so vertex buffer reads are
+                  (mostly) sequential
+
+and reports the ACMR (average cache miss ratio, i.e. # of vertices
+transformed per triangle, 0.5 is ideal for a large regular grid, 3.0 is
+worst) of a FIFO cache before and after.
+
+Call after any GenerateNormals & CreateUniqueVertices, as the first
+clears unique vertices, & the second numbers them in corner order,
+undoing the vertex fetch pass.
+
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- CountCacheMisses ----------
+/*!
+\brief count the misses of a simulated FIFO post transform vertex cache
+\author Gareth Edwards
+\param const INT *index [in] 3 vertices per triangle
+\param INT number_of_indices [in]
+\param INT number_of_vertices [in]
+\param INT cache_size [in] # of cache entries
+\return INT # of misses (i.e. # of vertices transformed)
+*/
+INT DotObjUtilities::PI_DotObjUtilities::CountCacheMisses
+		(
+			const INT *index,        // [in]
+			INT number_of_indices,   // [in]
+			INT number_of_vertices,  // [in]
+			INT cache_size           // [in]
+		)
+{
+
+	//
+	// note: a vertex is in a FIFO cache if it was one of the last
+	// cache_size vertices added, so each vertex only needs to know
+	// when (i.e. at which miss) it was last added
+	//
+
+	std::vector<INT> added(number_of_vertices, -cache_size - 1);
+	INT misses = 0;
+	for ( INT i = 0; i < number_of_indices; i++ )
+	{
+		INT v = *(index + i);
+		if ( misses - added[v] > cache_size )
+		{
+			added[v] = misses++;
+		}
+	}
+
+	return misses;
+}
+
+
+// ---------- OptimiseVertexCache ----------
+/*!
+\brief get a vertex cache optimised triangle order (Forsyth)
+\author Gareth Edwards
+\param const INT *index [in] 3 vertices per triangle
+\param INT number_of_triangles [in]
+\param INT number_of_vertices [in]
+\param INT *triangle_order [out] # of triangles
+*/
+VOID DotObjUtilities::PI_DotObjUtilities::OptimiseVertexCache
+		(
+			const INT *index,          // [in]
+			INT number_of_triangles,   // [in]
+			INT number_of_vertices,    // [in]
+			INT *triangle_order        // [out]
+		)
+{
+
+	// ---- local
+		const INT   max_cache_size      = 32;
+		const FLOAT cache_decay_power   = 1.5f;
+		const FLOAT last_triangle_score = 0.75f;
+		const FLOAT valence_boost_scale = 2.0f;
+		const FLOAT valence_boost_power = 0.5f;
+		const INT   max_valence         = 32;
+
+	// ---- score tables, by cache position & by # of triangles left
+		FLOAT cache_position_score[max_cache_size];
+		for ( INT i = 0; i < max_cache_size; i++ )
+		{
+			cache_position_score[i] = i < 3 ? last_triangle_score :
+				(FLOAT)pow(1.0f - (FLOAT)( i - 3 ) / ( max_cache_size - 3 ), cache_decay_power);
+		}
+		FLOAT valence_score[max_valence] = { 0 };
+		for ( INT i = 1; i < max_valence; i++ )
+			valence_score[i] = valence_boost_scale * (FLOAT)pow((FLOAT)i, -valence_boost_power);
+
+	// ---- lambda: score a vertex
+		auto score = [&](INT cache_position, INT triangles_left)
+		{
+			if ( triangles_left == 0 ) return -1.0f;
+			FLOAT s = cache_position < 0 ? 0 : cache_position_score[cache_position];
+			return s + ( triangles_left < max_valence ? valence_score[triangles_left] :
+				valence_boost_scale * (FLOAT)pow((FLOAT)triangles_left, -valence_boost_power) );
+		};
+
+	// ---- triangles of each vertex (compressed rows)
+		INT number_of_indices = number_of_triangles * 3;
+		std::vector<INT> triangles_left(number_of_vertices, 0);
+		for ( INT i = 0; i < number_of_indices; i++ ) triangles_left[*(index + i)]++;
+		std::vector<INT> first(number_of_vertices + 1, 0);
+		for ( INT v = 0; v < number_of_vertices; v++ ) first[v + 1] = first[v] + triangles_left[v];
+		std::vector<INT> adjacent(number_of_indices);
+		{
+			std::vector<INT> fill(first.begin(), first.end() - 1);
+			for ( INT i = 0; i < number_of_indices; i++ ) adjacent[fill[*(index + i)]++] = i / 3;
+		}
+
+	// ---- initial scores
+		std::vector<FLOAT> vertex_score(number_of_vertices);
+		for ( INT v = 0; v < number_of_vertices; v++ ) vertex_score[v] = score(-1, triangles_left[v]);
+		std::vector<FLOAT> triangle_score(number_of_triangles);
+		std::vector<BOOL>  triangle_drawn(number_of_triangles, FALSE);
+		INT best = -1;
+		for ( INT t = 0; t < number_of_triangles; t++ )
+		{
+			const INT *tv = index + t * 3;
+			triangle_score[t] = vertex_score[tv[0]] + vertex_score[tv[1]] + vertex_score[tv[2]];
+			if ( best < 0 || triangle_score[t] > triangle_score[best] ) best = t;
+		}
+
+	// ---- LRU cache, + 3 so the vertices that fall out can be rescored
+		std::vector<INT> cache_position(number_of_vertices, -1);
+		INT cache[max_cache_size + 3], next_cache[max_cache_size + 3];
+		INT cache_count = 0;
+
+	// ---- draw the best triangle, until all are drawn
+		INT next_undrawn = 0;
+		for ( INT drawn = 0; drawn < number_of_triangles; drawn++ )
+		{
+
+			// ---- no candidate in the cache ? then the next undrawn
+				if ( best < 0 )
+				{
+					while ( triangle_drawn[next_undrawn] ) next_undrawn++;
+					best = next_undrawn;
+				}
+				*(triangle_order + drawn) = best;
+				triangle_drawn[best] = TRUE;
+				const INT *tv = index + best * 3;
+
+			// ---- remove from each vertex's triangles left
+				for ( INT k = 0; k < 3; k++ )
+				{
+					INT v = tv[k];
+					INT *a = adjacent.data() + first[v];
+					INT  n = triangles_left[v];
+					for ( INT i = 0; i < n; i++ )
+					{
+						if ( a[i] == best )
+						{
+							a[i] = a[n - 1];
+							break;
+						}
+					}
+					triangles_left[v]--;
+				}
+
+			// ---- move vertices to front of cache
+				INT next_cache_count = 0;
+				for ( INT k = 0; k < 3; k++ )
+				{
+					if ( k > 0 && tv[k] == tv[0] ) continue;
+					if ( k > 1 && tv[k] == tv[1] ) continue;
+					next_cache[next_cache_count++] = tv[k];
+				}
+				for ( INT i = 0; i < cache_count; i++ )
+				{
+					INT v = cache[i];
+					if ( v != tv[0] && v != tv[1] && v != tv[2] ) next_cache[next_cache_count++] = v;
+				}
+
+			// ---- rescore cached (& fallen out) vertices
+				for ( INT i = 0; i < next_cache_count; i++ )
+				{
+					INT v = next_cache[i];
+					cache_position[v] = i < max_cache_size ? i : -1;
+					vertex_score[v] = score(cache_position[v], triangles_left[v]);
+				}
+
+			// ---- rescore their triangles, & find best
+				best = -1;
+				FLOAT best_score = -1;
+				for ( INT i = 0; i < next_cache_count; i++ )
+				{
+					INT v = next_cache[i];
+					INT *a = adjacent.data() + first[v];
+					for ( INT j = 0; j < triangles_left[v]; j++ )
+					{
+						INT t = a[j];
+						const INT *av = index + t * 3;
+						triangle_score[t] = vertex_score[av[0]] + vertex_score[av[1]] + vertex_score[av[2]];
+						if ( triangle_score[t] > best_score )
+						{
+							best_score = triangle_score[t];
+							best = t;
+						}
+					}
+				}
+
+			// ---- keep
+				cache_count = next_cache_count < max_cache_size ? next_cache_count : max_cache_size;
+				memcpy(cache, next_cache, cache_count * sizeof(INT));
+
+		}
+
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- mesh optimise ----------
+
+
+// ---------- GetACMR ----------
+/*!
+\brief get flat mesh ACMR (average cache miss ratio)
+\author Gareth Edwards
+\param DotObjMesh *mesh [in]
+\param INT cache_size [in] # of FIFO cache entries (e.g. 16 or 32)
+\return FLOAT # of vertices transformed per triangle (0 if no triangles)
+\note triangulates & creates unique vertices if not already done
+*/
+FLOAT DotObjUtilities::GetACMR(DotObjMesh *mesh, INT cache_size)
+{
+
+	// ---- check
+		if ( mesh == NULL || cache_size < 1 ) return 0;
+
+	// ---- triangulated & unique vertices ?
+		INT number_of_triangles = GetNumberOfTriangles(mesh);
+		if ( number_of_triangles == 0 ) return 0;
+		if ( mesh->GetNumberOfTriangles() != number_of_triangles )
+			if ( Triangulate(mesh) != SUCCESS_OK ) return 0;
+		if ( mesh->GetNumberOfUniqueVertices() == 0 ) CreateUniqueVertices(mesh);
+
+	// ---- unique vertex of each triangle corner
+		INT *triangle      = mesh->GetTriangles();
+		INT *corner_vertex = mesh->GetCornerVertices();
+		std::vector<INT> index(number_of_triangles * 3);
+		for ( INT i = 0; i < number_of_triangles * 3; i++ )
+			index[i] = *(corner_vertex + *(triangle + i));
+
+	// ---- misses
+		INT misses = pi_dot_obj_utilities->CountCacheMisses(
+				index.data(),
+				number_of_triangles * 3,
+				mesh->GetNumberOfUniqueVertices(),
+				cache_size
+			);
+
+	return (FLOAT)misses / number_of_triangles;
+}
+
+
+// ---------- OptimiseMesh ----------
+/*!
+\brief optimise flat mesh triangle & unique vertex order for the GPU
+\author Gareth Edwards
+\param DotObjMesh *mesh [in & out]
+\return HRESULT (SUCCESS_OK if ok)
+\note triangulates & creates unique vertices if not already done
+\note reports ACMR before & after via OutputDebugString
+*/
+HRESULT DotObjUtilities::OptimiseMesh(DotObjMesh *mesh)
+{
+
+	// ---- check
+		if ( mesh == NULL ) return SUCCESS_FAULT;
+
+	// ---- local
+		using namespace std::chrono;
+		auto start = high_resolution_clock::now();
+
+	// ---- triangulated & unique vertices ?
+		INT number_of_triangles = GetNumberOfTriangles(mesh);
+		if ( number_of_triangles == 0 ) return SUCCESS_FAULT;
+		if ( mesh->GetNumberOfTriangles() != number_of_triangles )
+			if ( Triangulate(mesh) != SUCCESS_OK ) return SUCCESS_FAULT;
+		if ( mesh->GetNumberOfUniqueVertices() == 0 ) CreateUniqueVertices(mesh);
+
+	// ---- before
+		FLOAT acmr_16 = GetACMR(mesh, 16);
+		FLOAT acmr_32 = GetACMR(mesh, 32);
+
+	// ---- local
+		INT  number_of_unique = mesh->GetNumberOfUniqueVertices();
+		INT  number_of_corners = mesh->GetNumberOfCorners();
+		INT *triangle      = mesh->GetTriangles();
+		INT *unique        = mesh->GetUniqueVertices();
+		INT *corner_vertex = mesh->GetCornerVertices();
+
+	// ---- vertex cache: reorder triangles
+		{
+			std::vector<INT> index(number_of_triangles * 3);
+			for ( INT i = 0; i < number_of_triangles * 3; i++ )
+				index[i] = *(corner_vertex + *(triangle + i));
+
+			std::vector<INT> order(number_of_triangles);
+			pi_dot_obj_utilities->OptimiseVertexCache(
+					index.data(),
+					number_of_triangles,
+					number_of_unique,
+					order.data()
+				);
+
+			std::vector<INT> reordered(number_of_triangles * 3);
+			for ( INT t = 0; t < number_of_triangles; t++ )
+				memcpy(reordered.data() + t * 3, triangle + order[t] * 3, 3 * sizeof(INT));
+			memcpy(triangle, reordered.data(), number_of_triangles * 3 * sizeof(INT));
+
+			//
+			// note: bvh leaves select triangles by index, so follow them
+			//
+			if ( mesh->GetNumberOfBvhNodes() > 0 )
+			{
+				std::vector<INT> moved(number_of_triangles);
+				for ( INT t = 0; t < number_of_triangles; t++ ) moved[order[t]] = t;
+				INT *bvh_triangle = mesh->GetBvhTriangles();
+				for ( INT t = 0; t < number_of_triangles; t++ )
+					*(bvh_triangle + t) = moved[*(bvh_triangle + t)];
+			}
+		}
+
+	// ---- vertex fetch: renumber unique vertices in order of first use
+		{
+			std::vector<INT> renumber(number_of_unique, -1);
+			INT next = 0;
+			for ( INT i = 0; i < number_of_triangles * 3; i++ )
+			{
+				INT u = *(corner_vertex + *(triangle + i));
+				if ( renumber[u] < 0 ) renumber[u] = next++;
+			}
+
+			//
+			// note: vertices used by no triangle (i.e. of faces with less
+			// than 3 corners) go last
+			//
+			for ( INT u = 0; u < number_of_unique; u++ )
+				if ( renumber[u] < 0 ) renumber[u] = next++;
+
+			std::vector<INT> reordered(number_of_unique);
+			for ( INT u = 0; u < number_of_unique; u++ ) reordered[renumber[u]] = unique[u];
+			memcpy(unique, reordered.data(), number_of_unique * sizeof(INT));
+			for ( INT c = 0; c < number_of_corners; c++ )
+				*(corner_vertex + c) = renumber[*(corner_vertex + c)];
+
+			//
+			// note: lod triangles are of unique vertices, so follow them
+			//
+			INT  number_of_lod_indices = mesh->GetNumberOfLods() > 0 ?
+				*(mesh->GetLodFirst() + mesh->GetNumberOfLods()) : 0;
+			INT *lod_index = mesh->GetLodIndices();
+			for ( INT i = 0; i < number_of_lod_indices; i++ )
+				*(lod_index + i) = renumber[*(lod_index + i)];
+		}
+
+	// ---- tell
+		DOUBLE ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - start).count();
+		CHAR msg[256];
+		sprintf_s(msg, 256, "OptimiseMesh: %d triangles, %d vertices - %.1f ms\n",
+				number_of_triangles,
+				number_of_unique,
+				ms
+			);
+		OutputDebugString(msg);
+		sprintf_s(msg, 256, "   ACMR (FIFO 16) %.3f -> %.3f\n", acmr_16, GetACMR(mesh, 16));
+		OutputDebugString(msg);
+		sprintf_s(msg, 256, "   ACMR (FIFO 32) %.3f -> %.3f\n", acmr_32, GetACMR(mesh, 32));
+		OutputDebugString(msg);
+
+	return SUCCESS_OK;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
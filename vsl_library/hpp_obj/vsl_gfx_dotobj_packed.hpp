@@ -0,0 +1,213 @@
+////////////////////////////////////////////////////////////////////////////////
+
+// ---------- vsl_gfx_dotobj_packed.hpp ----------
+/*!
+\file vsl_gfx_dotobj_packed.hpp
+\brief DotObjUtilities flat mesh packed (quantised) vertex buffer methods
+\author Gareth Edwards
+
+\note
+
+GetIndexedVertexBuffer writes 6 or 8 FLOATs (24 or 32 bytes) a vertex.
+GetPackedVertexBuffer writes the same unique vertices, encoded as per
+vsl_system::Vsl_Vertex_Packing (see vsl_maths.h), e.g.:
+
+	using vsl_system::Vsl_Vertex_Packing;
+	INT   format = VS_XYZ | VS_NORMAL | VS_TEX1;
+	FLOAT param[7] = { 1, 1, 1, 1, 0, 0, 0 }; // scale, width, height, depth & x, y, z offset
+	UINT  packing = Vsl_Vertex_Packing::POSITION_16 |
+		Vsl_Vertex_Packing::NORMAL_OCT_16 | Vsl_Vertex_Packing::TEXCOORD_HALF;
+	dot_obj_utilities.GenerateNormals(mesh, DotObjUtilities::NormalMode::AREA_WEIGHTED, 180); // optional
+	INT   number_of_vertices = dot_obj_utilities.CreateUniqueVertices(mesh);
+	INT   stride = dot_obj_utilities.GetPackedVertexSize(format, packing); // 16
+	BYTE *packed = new BYTE[number_of_vertices * stride];
+	FLOAT dequantise[6];
+	dot_obj_utilities.GetPackedVertexBuffer(mesh, param, packed, number_of_vertices, format, packing, dequantise);
+
+The index buffer is as per GetTriangleIndexBuffer.
+
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- mesh get packed buffers ----------
+
+
+// ---------- GetPackedVertexSize ----------
+/*!
+\brief get # of bytes per packed vertex
+\author Gareth Edwards
+\param INT vertex_format [in] vertex format (VS_XYZ | VS_NORMAL [| VS_TEX1])
+\param UINT packing [in] Vsl_Vertex_Packing::Packing flags
+\return INT # of bytes (0 if packing is invalid)
+*/
+INT DotObjUtilities::GetPackedVertexSize(
+		INT vertex_format,
+		UINT packing
+	)
+{
+	return (INT)vsl_system::Vsl_Vertex_Packing::GetStride(vertex_format & (VS_XYZ | VS_NORMAL | VS_TEX1), packing);
+}
+
+
+// ---------- GetPackedVertexBuffer ----------
+/*!
+\brief get flat mesh unique vertex buffer, packed
+\author Gareth Edwards
+\param DotObjMesh *mesh [in]
+\param FLOAT *object_param [in] scale, width, height, depth, x, y & z offset
+\param BYTE *packed_buffer [in & out] vertex_total * GetPackedVertexSize bytes
+\param INT vertex_total [in] # of vertices
+\param INT vertex_format [in] vertex format
+\param UINT packing [in] Vsl_Vertex_Packing::Packing flags
+\param FLOAT *dequantise [out] 6 FLOATs, position AABB min x, y, z & extent x, y, z
+\return VS_ERROR <= INT else SUCCESS_OK, etc...
+\note vertices are as per GetIndexedVertexBuffer
+*/
+INT DotObjUtilities::GetPackedVertexBuffer(
+		DotObjMesh *mesh,
+		FLOAT *object_param,
+		BYTE *packed_buffer,
+		INT vertex_total,
+		INT vertex_format,
+		UINT packing,
+		FLOAT *dequantise
+	)
+{
+
+	// ---- a lot can go wrong!
+		try
+		{
+
+			// ---- check
+				if ( mesh == NULL )                        throw("mesh: NULL");
+				if ( packed_buffer == NULL )               throw("packed buffer: NULL");
+				if ( GetPackedVertexSize(vertex_format, packing) == 0 ) throw("packing: invalid");
+
+			// ---- float vertices
+				BOOL texture = vertex_format & VS_TEX1 ? TRUE : FALSE;
+				if ( mesh->GetNumberOfUniqueVertices() == 0 ) CreateUniqueVertices(mesh);
+				INT number_of_unique = mesh->GetNumberOfUniqueVertices();
+				std::vector<FLOAT> vertex_buffer((size_t)number_of_unique * (texture ? 8 : 6));
+				if ( GetIndexedVertexBuffer(
+						mesh,
+						object_param,
+						vertex_buffer.data(),
+						vertex_total,
+						vertex_format
+					) != SUCCESS_OK )                      throw("vertex buffer: FAULT");
+
+			// ---- pack
+				vsl_system::Vsl_Vertex_Packing::Pack(
+						vertex_buffer.data(),
+						(UINT)number_of_unique,
+						vertex_format & (VS_XYZ | VS_NORMAL | VS_TEX1),
+						packing,
+						packed_buffer,
+						dequantise
+					);
+
+		}
+		catch (CHAR * msg)
+		{
+			OutputDebugString(msg);
+			OutputDebugString("\n");
+			return SUCCESS_FAULT;
+		}
+
+	return SUCCESS_OK;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- BenchmarkPacking ----------
+/*!
+\brief time vertex packing, & report bytes & round trip error of each packing
+\author Gareth Edwards
+\param INT number_of_faces [in] approximate # of triangles in a synthetic grid
+\return HRESULT (SUCCESS_OK if ok)
+\note the grid is made bumpy, & given smooth normals, so normals vary
+*/
+HRESULT DotObjUtilities::BenchmarkPacking(
+		INT number_of_faces
+	)
+{
+
+	// ---- local
+		using namespace std::chrono;
+		using vsl_system::Vsl_Vertex_Packing;
+		PI_DotObjUtilities *pi = pi_dot_obj_utilities;
+
+	// ---- mesh
+		DotObjMesh mesh;
+		{
+			std::string data;
+			pi->CreateGridData(&data, number_of_faces, TRUE);
+			if ( ParseView(&mesh, data.data(), (INT64)data.size()) != SUCCESS_OK ) return SUCCESS_FAULT;
+		}
+		for ( INT c = 0; c < mesh.GetNumberOfCorners(); c++ )
+			*(mesh.GetCorners() + c * 3 + 2) = -1;
+		mesh.ResizeNormals(0);
+		if ( GenerateNormals(&mesh, NormalMode::AREA_WEIGHTED, 180) != SUCCESS_OK ) return SUCCESS_FAULT;
+		INT number_of_vertices = CreateUniqueVertices(&mesh);
+
+	// ---- float vertices
+		INT   format = VS_XYZ | VS_NORMAL | VS_TEX1;
+		FLOAT param[7] = { 1, 1, 1, 1, 0, 0, 0 };
+		std::vector<FLOAT> vertex_buffer((size_t)number_of_vertices * 8);
+		std::vector<FLOAT> decoded((size_t)number_of_vertices * 8);
+		if ( GetIndexedVertexBuffer(&mesh, param, vertex_buffer.data(), number_of_vertices, format) != SUCCESS_OK )
+			return SUCCESS_FAULT;
+
+	// ---- tell
+		CHAR msg[256];
+		sprintf_s(msg, 256, "BenchmarkPacking: %d vertices\n", number_of_vertices);
+		OutputDebugString(msg);
+
+	// ---- for each packing
+		const UINT packings[] =
+		{
+			0,
+			Vsl_Vertex_Packing::POSITION_16,
+			Vsl_Vertex_Packing::NORMAL_OCT_16,
+			Vsl_Vertex_Packing::NORMAL_1010102,
+			Vsl_Vertex_Packing::TEXCOORD_HALF,
+			Vsl_Vertex_Packing::POSITION_16 | Vsl_Vertex_Packing::NORMAL_OCT_16  | Vsl_Vertex_Packing::TEXCOORD_HALF,
+			Vsl_Vertex_Packing::POSITION_16 | Vsl_Vertex_Packing::NORMAL_1010102 | Vsl_Vertex_Packing::TEXCOORD_HALF,
+		};
+		for ( UINT packing : packings )
+		{
+
+			// ---- pack
+				INT stride = GetPackedVertexSize(format, packing);
+				std::vector<BYTE> packed((size_t)number_of_vertices * stride);
+				FLOAT dequantise[6];
+				auto start = high_resolution_clock::now();
+				HRESULT hr = GetPackedVertexBuffer(&mesh, param, packed.data(), number_of_vertices, format, packing, dequantise);
+				DOUBLE ms = duration<DOUBLE, std::milli>(high_resolution_clock::now() - start).count();
+				if ( hr != SUCCESS_OK ) return SUCCESS_FAULT;
+
+			// ---- round trip
+				Vsl_Vertex_Packing::Unpack(packed.data(), number_of_vertices, format, packing, dequantise, decoded.data());
+				FLOAT error[3];
+				Vsl_Vertex_Packing::GetError(vertex_buffer.data(), decoded.data(), number_of_vertices, format, error);
+
+			// ---- tell
+				sprintf_s(msg, 256, "   packing 0x%02x - %2d bytes %6.1f MB - %7.1f ms - error position %.7f normal %.4f deg texcoord %.7f\n",
+						packing,
+						stride,
+						(DOUBLE)packed.size() / (1024 * 1024),
+						ms,
+						error[0],
+						error[1],
+						error[2]
+					);
+				OutputDebugString(msg);
+
+		}
+
+	return SUCCESS_OK;
+}
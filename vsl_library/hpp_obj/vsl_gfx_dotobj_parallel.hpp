@@ -0,0 +1,212 @@
+////////////////////////////////////////////////////////////////////////////////
+
+// ---------- vsl_gfx_dotobj_parallel.hpp ----------
+/*!
+\file vsl_gfx_dotobj_parallel.hpp
+\brief DotObjUtilities multi-threaded (chunked) parse methods
+\author Gareth Edwards
+
+\note
+
+A view is split into chunks at line boundaries, one per thread, and
+parsed in two passes:
+
+   1. each thread counts the positions, texcoords, normals, faces and
+      corners in its chunk (CensusChunk),
+
+   2. an exclusive prefix sum of those counts gives every chunk the
+      offset at which it writes into the (now exactly sized) mesh
+      arrays, and the # of vertices that precede it, so negative
+      (relative) indices resolve correctly (ParseChunk).
+
+The faces are then triangulated (see vsl_gfx_dotobj_triangulate.hpp).
+
+As each chunk writes to its own disjoint slice of the arrays no locks
+are required, and the result is identical for any # of threads.
+
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- mesh io threads ----------
+
+INT DotObjUtilities::GetNumberOfThreads()
+{
+	return pi_dot_obj_utilities->_number_of_threads;
+}
+
+VOID DotObjUtilities::SetNumberOfThreads(INT number_of_threads)
+{
+	//
+	// note: <= 0 is "one per hardware thread"
+	//
+	pi_dot_obj_utilities->_number_of_threads = number_of_threads;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- SplitView ----------
+/*!
+\brief split a read only view into chunks that start at a line
+\author Gareth Edwards
+\param const CHAR *data [in] view
+\param INT64 size [in] of view
+\param INT max_chunks [in] maximum # of chunks
+\param const CHAR **chunk [out] max_chunks + 1 chunk start pointers
+\return INT # of chunks (chunk i is chunk[i] to chunk[i+1])
+\note small views are NOT split, as thread start up would dominate
+*/
+INT DotObjUtilities::PI_DotObjUtilities::SplitView
+		(
+			const CHAR *data,    // [in]
+			INT64 size,          // [in]
+			INT max_chunks,      // [in]
+			const CHAR **chunk   // [out]
+		)
+{
+
+	// ---- local
+		const INT64 min_chunk_size = 1 << 20;
+		const CHAR *end = data + size;
+
+	// ---- # of chunks
+		INT64 number_of_chunks = size / min_chunk_size;
+		number_of_chunks = number_of_chunks < 1 ? 1 :
+			( number_of_chunks > max_chunks ? max_chunks : number_of_chunks );
+
+	// ---- move each nominal boundary on to the start of the next line
+		INT count = 0;
+		chunk[count++] = data;
+		for ( INT64 i = 1; i < number_of_chunks; i++ )
+		{
+			const CHAR *c = data + size * i / number_of_chunks;
+			if ( c <= chunk[count - 1] ) continue;
+			const CHAR *eol = (const CHAR *)memchr(c - 1, '\n', (size_t)(end - c + 1));
+			if ( eol == NULL || eol + 1 >= end ) break;
+			if ( eol + 1 > chunk[count - 1] ) chunk[count++] = eol + 1;
+		}
+		chunk[count] = end;
+
+	return count;
+}
+
+
+// ---------- ParseView ----------
+/*!
+\brief parse a read only ".obj" format view into a flat mesh
+\author Gareth Edwards
+\param DotObjMesh *mesh [in]
+\param const CHAR *data [in] view (NOT written to or terminated)
+\param INT64 size [in] of view
+\return HRESULT (SUCCESS_OK if ok, SUCCESS_FAULT if a geometry index is out of range)
+*/
+HRESULT DotObjUtilities::ParseView(
+		DotObjMesh *mesh,
+		const CHAR *data,
+		INT64       size
+	)
+{
+
+	// ---- error
+		if ( mesh == NULL || data == NULL ) return SUCCESS_FAULT;
+
+	// ---- local
+		typedef PI_DotObjUtilities::DotObjCursor Cursor;
+		PI_DotObjUtilities *pi = pi_dot_obj_utilities;
+
+	// ---- # of threads
+		INT number_of_threads = pi->_number_of_threads;
+		if ( number_of_threads <= 0 )
+		{
+			number_of_threads = (INT)std::thread::hardware_concurrency();
+			number_of_threads = number_of_threads < 1 ? 1 : number_of_threads;
+		}
+
+	// ---- chunks
+		std::vector<const CHAR *> chunk(number_of_threads + 1);
+		INT number_of_chunks = pi->SplitView(data, size, number_of_threads, chunk.data());
+		std::vector<Cursor> cursor(number_of_chunks);
+
+	// ---- lambda: invoke function(chunk index) once per chunk, concurrently if > 1
+		auto for_each_chunk = [&](auto function)
+		{
+			if ( number_of_chunks == 1 )
+			{
+				function(0);
+				return;
+			}
+			std::vector<std::thread> thread;
+			thread.reserve(number_of_chunks - 1);
+			for ( INT i = 1; i < number_of_chunks; i++ )
+				thread.push_back(std::thread(function, i));
+			function(0);
+			for ( auto &t : thread ) t.join();
+		};
+
+	// ---- census
+		for_each_chunk([&](INT i)
+		{
+			pi->CensusChunk(chunk[i], chunk[i + 1], cursor[i]._total);
+		});
+
+	// ---- exclusive prefix sum of census
+		INT total[Cursor::COUNT_SIZE] = { 0, 0, 0, 0, 0 };
+		for ( auto &c : cursor )
+		{
+			for ( INT k = 0; k < Cursor::COUNT_SIZE; k++ )
+			{
+				c._base[k] = total[k];
+				total[k] += c._total[k];
+			}
+		}
+
+	// ---- size mesh
+		mesh->Resize(
+				total[Cursor::POSITIONS],
+				total[Cursor::TEXCOORDS],
+				total[Cursor::NORMALS],
+				total[Cursor::FACES],
+				total[Cursor::CORNERS]
+			);
+
+	// ---- point each cursor at its slice
+		for ( auto &c : cursor )
+		{
+			c._positions   = mesh->GetPositions() + c._base[Cursor::POSITIONS] * 3;
+			c._texcoords   = mesh->GetTexcoords() + c._base[Cursor::TEXCOORDS] * 2;
+			c._normals     = mesh->GetNormals()   + c._base[Cursor::NORMALS]   * 3;
+			c._faces       = mesh->GetFaces()     + c._base[Cursor::FACES];
+			c._corners     = mesh->GetCorners()   + c._base[Cursor::CORNERS]   * 3;
+			c._corner_base = c._base[Cursor::CORNERS];
+		}
+
+	// ---- parse
+		std::vector<HRESULT> result(number_of_chunks, SUCCESS_OK);
+		for_each_chunk([&](INT i)
+		{
+			result[i] = pi->ParseChunk(&cursor[i], chunk[i], chunk[i + 1]);
+		});
+
+	// ---- check every chunk filled exactly the slice its census sized
+		for ( INT i = 0; i < number_of_chunks; i++ )
+		{
+			if ( result[i] != SUCCESS_OK ) return result[i];
+			for ( INT k = 0; k < Cursor::COUNT_SIZE; k++ )
+				if ( cursor[i]._count[k] != cursor[i]._total[k] ) return SUCCESS_FAULT;
+		}
+
+	// ---- close last face
+		*(mesh->GetFaces() + total[Cursor::FACES]) = total[Cursor::CORNERS];
+
+	// ---- triangulate (fails if a geometry index is out of range)
+		HRESULT hr = Triangulate(mesh);
+		if ( hr != SUCCESS_OK ) return hr;
+
+	return SUCCESS_OK;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////
+
+// ---------- vsl_gfx_dotobj_scan.hpp ----------
+/*!
+\file vsl_gfx_dotobj_scan.hpp
+\brief DotObjUtilities locale free numeric scan methods
+\author Gareth Edwards
+
+\note
+
+ScanFloat and ScanInt convert a number in place, starting at a pointer
+and stopping at the first character that is not part of the number,
+which is returned so the caller can carry on from there. There is no
+copy, no terminator and no locale lookup (unlike atof & atoi), so face
+"v/vt/vn" triples are converted in a single pass over the characters.
+
+A float is accumulated as an integer mantissa (up to 19 significant
+digits) and a decimal exponent, then scaled once by an exact power of
+ten, so typical ".obj" values (e.g. "-0.123456") round exactly as atof.
+
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- ScanFloat ----------
+/*!
+\brief scan a FLOAT, e.g. "1", "-0.5", ".25", "1.5e-3"
+\author Gareth Edwards
+\param const CHAR **c [in & out] first character, returned as first character after number
+\param const CHAR *end [in] end of data
+\return FLOAT (0 if no number)
+*/
+FLOAT DotObjUtilities::PI_DotObjUtilities::ScanFloat
+		(
+			const CHAR **c,      // [in & out]
+			const CHAR *end      // [in]
+		)
+{
+
+	// ---- local
+		static const DOUBLE power_of_ten[23] =
+		{
+			1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+			1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+			1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+		const CHAR *p = *c;
+
+	// ---- sign
+		BOOL negative = FALSE;
+		if ( p < end && ( *p == '-' || *p == '+' ) ) negative = *p++ == '-';
+
+	// ---- mantissa & exponent
+		UINT64 mantissa = 0;
+		INT    digits = 0;
+		INT    exponent = 0;
+		for ( ; p < end && *p >= '0' && *p <= '9'; p++ )
+		{
+			if ( digits < 19 )
+			{
+				mantissa = mantissa * 10 + (*p - '0');
+				if ( mantissa != 0 ) digits++;
+			}
+			else
+			{
+				exponent++;
+			}
+		}
+		if ( p < end && *p == '.' )
+		{
+			for ( p++; p < end && *p >= '0' && *p <= '9'; p++ )
+			{
+				if ( digits < 19 )
+				{
+					mantissa = mantissa * 10 + (*p - '0');
+					if ( mantissa != 0 ) digits++;
+					exponent--;
+				}
+			}
+		}
+
+	// ---- "e" or "E" exponent (only if followed by digits)
+		if ( p < end && ( *p == 'e' || *p == 'E' ) )
+		{
+			const CHAR *q = p + 1;
+			BOOL exponent_negative = FALSE;
+			if ( q < end && ( *q == '-' || *q == '+' ) ) exponent_negative = *q++ == '-';
+			if ( q < end && *q >= '0' && *q <= '9' )
+			{
+				INT e = 0;
+				for ( ; q < end && *q >= '0' && *q <= '9'; q++ )
+					if ( e < 1000 ) e = e * 10 + (*q - '0');
+				exponent += exponent_negative ? -e : e;
+				p = q;
+			}
+		}
+		*c = p;
+
+	// ---- scale
+		DOUBLE value = (DOUBLE)mantissa;
+		if ( exponent < 0 )
+			value = exponent >= -22 ? value / power_of_ten[-exponent] : value * pow(10.0, exponent);
+		else if ( exponent > 0 )
+			value = exponent <=  22 ? value * power_of_ten[exponent] : value * pow(10.0, exponent);
+
+	return (FLOAT)(negative ? -value : value);
+}
+
+
+// ---------- ScanInt ----------
+/*!
+\brief scan an INT, e.g. "12", "-3" (an ".obj" relative index)
+\author Gareth Edwards
+\param const CHAR **c [in & out] first character, returned as first character after number
+\param const CHAR *end [in] end of data
+\return INT (0 if no number)
+*/
+INT DotObjUtilities::PI_DotObjUtilities::ScanInt
+		(
+			const CHAR **c,      // [in & out]
+			const CHAR *end      // [in]
+		)
+{
+	const CHAR *p = *c;
+	BOOL negative = FALSE;
+	if ( p < end && ( *p == '-' || *p == '+' ) ) negative = *p++ == '-';
+	INT value = 0;
+	for ( ; p < end && *p >= '0' && *p <= '9'; p++ )
+		value = value * 10 + (*p - '0');
+	*c = p;
+	return negative ? -value : value;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
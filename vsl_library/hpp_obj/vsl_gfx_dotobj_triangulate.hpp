@@ -0,0 +1,269 @@
+////////////////////////////////////////////////////////////////////////////////
+
+// ---------- vsl_gfx_dotobj_triangulate.hpp ----------
+/*!
+\file vsl_gfx_dotobj_triangulate.hpp
+\brief DotObjUtilities polygon triangulation methods
+\author Gareth Edwards
+
+\note
+
+Each polygon is projected onto the plane of its (Newell) normal, then:
+
+   convex  - fanned (0 1 2, 0 2 3, 0 3 4, etc..)
+
+   concave - ear clipped, i.e. repeatedly cut off a convex corner
+             whose triangle contains no other remaining corner
+
+A polygon of n corners always gives n - 2 triangles, so the flat mesh
+triangle array is sized before it is filled; the per polygon work
+space (DotObjPolygon) is reused, so there is no allocation per face.
+
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- TriangulatePolygon ----------
+/*!
+\brief triangulate a polygon
+\author Gareth Edwards
+\param DotObjPolygon *polygon [in & out] _point[0..n-1] set by caller, rest is work space
+\param INT n [in] # of corners
+\param INT *triangle [out] (n - 2) * 3 corner (0 to n-1) indices
+\return INT # of triangles
+*/
+INT DotObjUtilities::PI_DotObjUtilities::TriangulatePolygon
+		(
+			DotObjPolygon *polygon, // [in & out]
+			INT n,                  // [in]
+			INT *triangle           // [out]
+		)
+{
+
+	// ---- local
+		if ( n < 3 ) return 0;
+		INT *t = triangle;
+		auto fan = [&](INT a, INT b, INT c) { *(t + 0) = a; *(t + 1) = b; *(t + 2) = c; t += 3; };
+
+	// ---- triangle ?
+		if ( n == 3 )
+		{
+			fan(0, 1, 2);
+			return 1;
+		}
+
+	// ---- Newell normal
+		const FLOAT **point = polygon->_point.data();
+		FLOAT normal[3] = { 0, 0, 0 };
+		for ( INT i = 0, j = n - 1; i < n; j = i++ )
+		{
+			const FLOAT *pi = point[i], *pj = point[j];
+			normal[0] += (pj[1] - pi[1]) * (pj[2] + pi[2]);
+			normal[1] += (pj[2] - pi[2]) * (pj[0] + pi[0]);
+			normal[2] += (pj[0] - pi[0]) * (pj[1] + pi[1]);
+		}
+
+	// ---- project, dropping the dominant axis, & make counter clockwise
+		FLOAT ax = fabs(normal[0]), ay = fabs(normal[1]), az = fabs(normal[2]);
+		INT   drop = ax > ay ? ( ax > az ? 0 : 2 ) : ( ay > az ? 1 : 2 );
+		INT   u_axis = drop == 0 ? 1 : 0;
+		INT   v_axis = drop == 2 ? 1 : 2;
+		FLOAT flip = normal[drop] < 0 ? -1.0f : 1.0f;
+		FLOAT *uv = polygon->_uv.data();
+		for ( INT i = 0; i < n; i++ )
+		{
+			*(uv + i * 2 + 0) = point[i][u_axis];
+			*(uv + i * 2 + 1) = point[i][v_axis] * ( drop == 1 ? -flip : flip );
+		}
+
+	// ---- lambda: twice signed area of uv triangle (> 0 if counter clockwise)
+		auto area = [&](INT a, INT b, INT c)
+		{
+			FLOAT *pa = uv + a * 2, *pb = uv + b * 2, *pc = uv + c * 2;
+			return ( pb[0] - pa[0] ) * ( pc[1] - pa[1] ) - ( pb[1] - pa[1] ) * ( pc[0] - pa[0] );
+		};
+
+	// ---- convex ? then fan
+		BOOL convex = TRUE;
+		for ( INT i = 0; i < n && convex; i++ )
+			convex = area(( i + n - 1 ) % n, i, ( i + 1 ) % n) >= 0;
+		if ( convex )
+		{
+			for ( INT i = 2; i < n; i++ ) fan(0, i - 1, i);
+			return n - 2;
+		}
+
+	// ---- concave: ear clip a circular linked list of remaining corners
+		INT *prev = polygon->_prev.data();
+		INT *next = polygon->_next.data();
+		for ( INT i = 0; i < n; i++ )
+		{
+			prev[i] = ( i + n - 1 ) % n;
+			next[i] = ( i + 1 ) % n;
+		}
+
+	// ---- lambda: is a corner an ear ?
+		auto is_ear = [&](INT i)
+		{
+			INT a = prev[i], c = next[i];
+			if ( area(a, i, c) <= 0 ) return FALSE;
+			for ( INT p = next[c]; p != a; p = next[p] )
+			{
+				if ( area(a, i, p) >= 0 && area(i, c, p) >= 0 && area(c, a, p) >= 0 )
+					return FALSE;
+			}
+			return TRUE;
+		};
+
+	// ---- clip
+		INT remaining = n;
+		INT i = 0;
+		INT tries = 0;
+		while ( remaining > 3 )
+		{
+			if ( is_ear(i) )
+			{
+				fan(prev[i], i, next[i]);
+				next[prev[i]] = next[i];
+				prev[next[i]] = prev[i];
+				i = next[i];
+				remaining--;
+				tries = 0;
+			}
+			else if ( ++tries > remaining )
+			{
+				//
+				// note: no ear (self intersecting or degenerate), so fan
+				// what is left rather than loop forever
+				//
+				for ( INT p = next[next[i]]; p != i; p = next[p] )
+					fan(i, prev[p], p);
+				return n - 2;
+			}
+			else
+			{
+				i = next[i];
+			}
+		}
+		fan(prev[i], i, next[i]);
+
+	return n - 2;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- mesh triangulate ----------
+
+
+// ---------- Triangulate ----------
+/*!
+\brief triangulate every face of a flat mesh into its triangle array
+\author Gareth Edwards
+\param DotObjMesh *mesh [in & out]
+\return HRESULT (SUCCESS_OK if ok)
+\note faces with less than 3 corners give no triangles
+\note faces are split into one range per thread (see SetNumberOfThreads)
+*/
+HRESULT DotObjUtilities::Triangulate(DotObjMesh *mesh)
+{
+
+	// ---- check
+		if ( mesh == NULL ) return SUCCESS_FAULT;
+
+	// ---- local
+		INT   *face     = mesh->GetFaces();
+		INT   *corner   = mesh->GetCorners();
+		FLOAT *position = mesh->GetPositions();
+		INT    number_of_faces     = mesh->GetNumberOfFaces();
+		INT    number_of_positions = mesh->GetNumberOfPositions();
+		INT    number_of_triangles = GetNumberOfTriangles(mesh);
+
+	// ---- size
+		mesh->ResizeTriangles(number_of_triangles);
+		INT *triangles = mesh->GetTriangles();
+
+	// ---- # of threads
+		INT number_of_threads = pi_dot_obj_utilities->_number_of_threads;
+		if ( number_of_threads <= 0 )
+		{
+			number_of_threads = (INT)std::thread::hardware_concurrency();
+			number_of_threads = number_of_threads < 1 ? 1 : number_of_threads;
+		}
+		const INT min_faces_per_range = 1 << 16;
+		INT number_of_ranges = number_of_faces / min_faces_per_range;
+		number_of_ranges = number_of_ranges < 1 ? 1 :
+			( number_of_ranges > number_of_threads ? number_of_threads : number_of_ranges );
+
+	// ---- lambda: triangulate a range of faces
+		std::vector<HRESULT> result(number_of_ranges, SUCCESS_OK);
+		auto triangulate_range = [&](INT r)
+		{
+
+			// ---- faces
+				INT first_face = (INT)( (INT64)number_of_faces * r / number_of_ranges );
+				INT last_face  = (INT)( (INT64)number_of_faces * ( r + 1 ) / number_of_ranges );
+
+			// ---- first triangle (n - 2 for each previous face of n >= 3 corners)
+				INT t = 0;
+				for ( INT f = 0; f < first_face; f++ )
+				{
+					INT n = face[f + 1] - face[f];
+					t += n > 2 ? n - 2 : 0;
+				}
+
+			// ---- for each face
+				PI_DotObjUtilities::DotObjPolygon polygon;
+				for ( INT f = first_face; f < last_face; f++ )
+				{
+					INT n = face[f + 1] - face[f];
+					if ( n < 3 ) continue;
+
+					polygon.Resize(n);
+					for ( INT i = 0; i < n; i++ )
+					{
+						INT v = *(corner + ( face[f] + i ) * 3);
+						if ( v < 0 || v >= number_of_positions )
+						{
+							result[r] = SUCCESS_FAULT;
+							return;
+						}
+						polygon._point[i] = position + v * 3;
+					}
+
+					INT *triangle = triangles + t * 3;
+					t += pi_dot_obj_utilities->TriangulatePolygon(&polygon, n, triangle);
+					for ( INT i = 0; i < ( n - 2 ) * 3; i++ ) *(triangle + i) += face[f];
+				}
+
+		};
+
+	// ---- triangulate
+		if ( number_of_ranges == 1 )
+		{
+			triangulate_range(0);
+		}
+		else
+		{
+			std::vector<std::thread> thread;
+			for ( INT r = 1; r < number_of_ranges; r++ )
+				thread.push_back(std::thread(triangulate_range, r));
+			triangulate_range(0);
+			for ( auto &th : thread ) th.join();
+		}
+
+	// ---- ok ?
+		for ( auto hr : result )
+			if ( hr != SUCCESS_OK )
+			{
+				mesh->ResizeTriangles(0);
+				return hr;
+			}
+
+	return SUCCESS_OK;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
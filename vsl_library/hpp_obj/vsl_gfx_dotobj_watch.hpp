@@ -0,0 +1,265 @@
+////////////////////////////////////////////////////////////////////////////////
+
+// ---------- vsl_gfx_dotobj_watch.hpp ----------
+/*!
+\file vsl_gfx_dotobj_watch.hpp
+\brief DotObjUtilities flat mesh hot reload methods
+\author Gareth Edwards
+
+\note
+
+Watch starts a background thread that waits on a change notification
+for the folder holding a ".obj" file (with a timeout, so a missed or
+unsupported notification only delays a reload), and on a change to the
+file's last write time or size:
+
+   1. waits until the file is no longer being written (stamp unchanged
+      for SETTLE_MS, and the file can be opened for sharing)
+
+   2. reads it into a new DotObjMesh, using this object's read, thread,
+      cache and bvh modes (and CreateUniqueVertices, if the watched mesh
+      had unique vertices when Watch was called)
+
+   3. publishes the new mesh with an interlocked pointer exchange
+
+Reload, called by the owner (e.g. once per frame), exchanges the
+published mesh out and swaps its arrays into the owner's mesh, which is
+O(1), then hands the old arrays back to the background thread to be
+deleted. So the owner never waits on a read, parse or free.
+
+A failed read leaves the stamp alone, so the file is tried again on the
+next change or timeout.
+
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- mesh hot reload ----------
+
+
+// ---------- Watch ----------
+/*!
+\brief start watching a ".obj" file, reloading it on change
+\author Gareth Edwards
+\param DotObjMesh *mesh [in] owner's mesh, as read from filename
+\param CHAR *filename [in] ".obj" path/file name
+\return HRESULT (SUCCESS_OK if ok)
+\note one file per DotObjUtilities object; a second Watch replaces the first
+*/
+HRESULT DotObjUtilities::Watch(
+		DotObjMesh *mesh,
+		CHAR *filename
+	)
+{
+
+	// ---- check
+		if ( mesh == NULL || filename == NULL ) return SUCCESS_FAULT;
+
+	// ---- replace
+		Unwatch();
+
+	// ---- setup
+		PI_DotObjUtilities *pi = pi_dot_obj_utilities;
+		PI_DotObjUtilities::DotObjWatcher *watcher = &pi->_watcher;
+		watcher->_filename.assign(filename);
+		watcher->_unique = mesh->GetNumberOfUniqueVertices() > 0;
+		watcher->_reloads = 0;
+		if ( !pi->GetFileStamp(filename, &watcher->_stamp) ) return SUCCESS_FAULT;
+
+	// ---- notification for folder (may fail, e.g. on some network shares)
+		std::string folder(filename);
+		size_t slash = folder.find_last_of("\\/");
+		folder = slash == std::string::npos ? std::string(".") : folder.substr(0, slash);
+		watcher->_change = FindFirstChangeNotification(
+				folder.c_str(),
+				FALSE,
+				FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_FILE_NAME
+			);
+
+	// ---- stop event & thread
+		watcher->_stop = CreateEvent(NULL, TRUE, FALSE, NULL);
+		if ( watcher->_stop == NULL )
+		{
+			Unwatch();
+			return SUCCESS_FAULT;
+		}
+		watcher->_thread = std::thread(&PI_DotObjUtilities::WatchThread, pi);
+
+	return SUCCESS_OK;
+}
+
+
+// ---------- Unwatch ----------
+/*!
+\brief stop watching, discarding any reload not yet taken by Reload
+\author Gareth Edwards
+\return HRESULT (SUCCESS_OK if ok)
+*/
+HRESULT DotObjUtilities::Unwatch()
+{
+
+	// ---- stop thread
+		PI_DotObjUtilities::DotObjWatcher *watcher = &pi_dot_obj_utilities->_watcher;
+		if ( watcher->_thread.joinable() )
+		{
+			SetEvent(watcher->_stop);
+			watcher->_thread.join();
+		}
+
+	// ---- close
+		if ( watcher->_stop != NULL )
+		{
+			CloseHandle(watcher->_stop);
+			watcher->_stop = NULL;
+		}
+		if ( watcher->_change != INVALID_HANDLE_VALUE && watcher->_change != NULL )
+		{
+			FindCloseChangeNotification(watcher->_change);
+		}
+		watcher->_change = INVALID_HANDLE_VALUE;
+
+	// ---- delete
+		delete (DotObjMesh *)InterlockedExchangePointer((PVOID *)&watcher->_ready, NULL);
+		delete (DotObjMesh *)InterlockedExchangePointer((PVOID *)&watcher->_retired, NULL);
+
+	return SUCCESS_OK;
+}
+
+
+// ---------- Reload ----------
+/*!
+\brief if a reload of the watched file is ready, swap it into a mesh
+\author Gareth Edwards
+\param DotObjMesh *mesh [in & out] owner's mesh
+\return BOOL TRUE if mesh was reloaded (owner should rebuild buffers)
+*/
+BOOL DotObjUtilities::Reload(
+		DotObjMesh *mesh
+	)
+{
+
+	// ---- ready ?
+		PI_DotObjUtilities::DotObjWatcher *watcher = &pi_dot_obj_utilities->_watcher;
+		if ( mesh == NULL || watcher->_ready == NULL ) return FALSE;
+		DotObjMesh *ready = (DotObjMesh *)InterlockedExchangePointer((PVOID *)&watcher->_ready, NULL);
+		if ( ready == NULL ) return FALSE;
+
+	// ---- swap, then retire old arrays to the watch thread
+		mesh->Swap(ready);
+		delete (DotObjMesh *)InterlockedExchangePointer((PVOID *)&watcher->_retired, ready);
+
+	return TRUE;
+}
+
+
+// ---------- GetNumberOfReloads ----------
+/*!
+\brief get # of times the watched file has been read since Watch
+\author Gareth Edwards
+\return INT # of reloads (published, not necessarily taken by Reload)
+*/
+INT DotObjUtilities::GetNumberOfReloads()
+{
+	return (INT)pi_dot_obj_utilities->_watcher._reloads;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- GetFileStamp ----------
+/*!
+\brief get last write time & size of a file that can be opened for reading
+\author Gareth Edwards
+\param const CHAR *filename [in]
+\param DotObjStamp *stamp [out]
+\return BOOL TRUE if ok (FALSE if missing, or locked by a writer)
+*/
+BOOL DotObjUtilities::PI_DotObjUtilities::GetFileStamp
+		(
+			const CHAR *filename,        // [in]
+			DotObjStamp *stamp           // [out]
+		)
+{
+	HANDLE file = CreateFile(
+			filename,
+			GENERIC_READ,
+			FILE_SHARE_READ,
+			NULL,
+			OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL,
+			NULL
+		);
+	if ( file == INVALID_HANDLE_VALUE ) return FALSE;
+	LARGE_INTEGER size;
+	BOOL ok = GetFileTime(file, NULL, NULL, &stamp->_time) &&
+		GetFileSizeEx(file, &size);
+	stamp->_size = ok ? (INT64)size.QuadPart : -1;
+	CloseHandle(file);
+	return ok;
+}
+
+
+// ---------- WatchThread ----------
+/*!
+\brief watch thread: wait for a change, then read & publish a new mesh
+\author Gareth Edwards
+*/
+VOID DotObjUtilities::PI_DotObjUtilities::WatchThread()
+{
+
+	// ---- local
+		DotObjWatcher *watcher = &_watcher;
+		CHAR *filename = (CHAR *)watcher->_filename.c_str();
+		BOOL notify = watcher->_change != INVALID_HANDLE_VALUE && watcher->_change != NULL;
+		HANDLE wait[2] = { watcher->_stop, watcher->_change };
+
+	// ---- own utilities, so the owner's are never shared across threads
+		DotObjUtilities utilities;
+		utilities.SetReadMode(_read_mode);
+		utilities.SetNumberOfThreads(_number_of_threads);
+		utilities.SetCacheMode(_cache_mode);
+		utilities.SetBvhMode(_bvh_mode);
+
+	// ---- until stopped
+		for (;;)
+		{
+
+			// ---- wait
+				DWORD result = WaitForMultipleObjects(notify ? 2 : 1, wait, FALSE, DotObjWatcher::TIMEOUT_MS);
+				if ( result == WAIT_OBJECT_0 ) break;
+				if ( result == WAIT_OBJECT_0 + 1 ) FindNextChangeNotification(watcher->_change);
+
+			// ---- delete arrays retired by Reload
+				delete (DotObjMesh *)InterlockedExchangePointer((PVOID *)&watcher->_retired, NULL);
+
+			// ---- changed ?
+				DotObjStamp stamp;
+				if ( !GetFileStamp(filename, &stamp) ) continue;
+				if ( stamp == watcher->_stamp ) continue;
+
+			// ---- settled ? (else try again on the next change or timeout)
+				if ( WaitForSingleObject(watcher->_stop, DotObjWatcher::SETTLE_MS) == WAIT_OBJECT_0 ) break;
+				DotObjStamp settled;
+				if ( !GetFileStamp(filename, &settled) || !(settled == stamp) ) continue;
+
+			// ---- read
+				DotObjMesh *mesh = new DotObjMesh();
+				HRESULT hr = utilities.Read(mesh, filename);
+				if ( hr == SUCCESS_OK && watcher->_unique )
+					utilities.CreateUniqueVertices(mesh);
+				if ( hr != SUCCESS_OK )
+				{
+					delete mesh;
+					continue;
+				}
+
+			// ---- publish (replacing any reload not yet taken)
+				watcher->_stamp = settled;
+				delete (DotObjMesh *)InterlockedExchangePointer((PVOID *)&watcher->_ready, mesh);
+				InterlockedIncrement(&watcher->_reloads);
+
+		}
+
+}
@@ -0,0 +1,468 @@
+////////////////////////////////////////////////////////////////////////////////
+
+// ---------- vsl_gfx_dotobj_write.hpp ----------
+/*!
+\file vsl_gfx_dotobj_write.hpp
+\brief DotObjUtilities streaming (block buffered) write methods
+\author Gareth Edwards
+
+\note
+
+Both Write methods format straight into one of two fixed size blocks,
+and hand a full block to the file in one WriteFile call, so memory use
+is bounded by the block size however big the object is.
+
+   STREAMED - a full block is written on the calling thread
+
+   THREADED - a full block is written on a background thread, while
+              the calling thread formats into the other block
+
+Numbers are formatted in place (no sprintf, no locale lookup):
+
+   FormatFloat - the shortest decimal (1 to 9 significant digits)
+                 that ScanFloat reads back as exactly the same FLOAT
+
+   FormatInt   - decimal digits
+
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- mesh io write mode ----------
+
+DotObjUtilities::WriteMode DotObjUtilities::GetWriteMode()
+{
+	return pi_dot_obj_utilities->_write_mode;
+}
+
+VOID DotObjUtilities::SetWriteMode(WriteMode mode)
+{
+	pi_dot_obj_utilities->_write_mode = mode;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- FormatFloat ----------
+/*!
+\brief format a FLOAT as the shortest decimal that scans back exactly
+\author Gareth Edwards
+\param CHAR *c [in] first character, room for at least 24
+\param FLOAT value [in]
+\return CHAR * (first character after number)
+\note e.g. 0.5f as "0.5", 0.1f as "0.1", -1234.5f as "-1234.5" and
+1e-7f as "1e-07"; NaN & infinity (not ".obj" values) use sprintf
+*/
+CHAR *DotObjUtilities::PI_DotObjUtilities::FormatFloat
+		(
+			CHAR *c,             // [in]
+			FLOAT value          // [in]
+		)
+{
+
+	// ---- local
+		static const DOUBLE power_of_ten[23] =
+		{
+			1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+			1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+			1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+
+	// ---- special (only NaN & infinity have v - v != 0)
+		if ( value - value != 0 )
+		{
+			return c + sprintf_s(c, 24, "%g", value);
+		}
+		if ( value == 0 )
+		{
+			*c++ = '0';
+			return c;
+		}
+
+	// ---- sign
+		if ( value < 0 )
+		{
+			*c++ = '-';
+			value = -value;
+		}
+
+	// ---- lambda: m x 10^e, exactly as ScanFloat scales a mantissa
+		auto scale = [](DOUBLE m, INT e)
+		{
+			if ( e < 0 )
+				return e >= -22 ? m / power_of_ten[-e] : m * pow(10.0, e);
+			else if ( e > 0 )
+				return e <=  22 ? m * power_of_ten[e]  : m * pow(10.0, e);
+			return m;
+		};
+
+	// ---- shortest # of significant digits that scans back exactly
+		//
+		// note: digits x 10^exponent, where the first digit is at
+		// 10^magnitude (log10 may be one out, which only costs a try),
+		// and as more digits never fail to scan back, the # of digits
+		// is found by binary search (at most 4 tries)
+		//
+		INT    magnitude = (INT)floor(log10((DOUBLE)value));
+		UINT64 digits    = 0;
+		INT    exponent  = 0;
+		INT    low = 1, high = 10;
+		while ( low < high )
+		{
+			INT precision = (low + high) / 2;
+			INT e = magnitude - precision + 1;
+			UINT64 d = (UINT64)(scale((DOUBLE)value, -e) + 0.5);
+			if ( d != 0 && (FLOAT)scale((DOUBLE)d, e) == value )
+			{
+				digits = d;
+				exponent = e;
+				high = precision;
+			}
+			else
+			{
+				low = precision + 1;
+			}
+		}
+		if ( digits == 0 )
+		{
+			return c + sprintf_s(c, 24, "%.9g", value);
+		}
+
+	// ---- digits, without trailing zeros
+		while ( digits % 10 == 0 )
+		{
+			digits /= 10;
+			exponent++;
+		}
+		CHAR d[24];
+		INT  number_of_digits = 0;
+		for ( UINT64 r = digits; r != 0; r /= 10 )
+			d[number_of_digits++] = (CHAR)('0' + r % 10);
+
+	// ---- # of digits before the decimal point
+		INT point = number_of_digits + exponent;
+
+	// ---- e.g. "1234" or "12500"
+		if ( exponent >= 0 && point <= 9 )
+		{
+			while ( number_of_digits > 0 ) *c++ = d[--number_of_digits];
+			while ( exponent-- > 0 ) *c++ = '0';
+		}
+
+	// ---- e.g. "12.34"
+		else if ( point > 0 && exponent < 0 )
+		{
+			while ( number_of_digits > -exponent ) *c++ = d[--number_of_digits];
+			*c++ = '.';
+			while ( number_of_digits > 0 ) *c++ = d[--number_of_digits];
+		}
+
+	// ---- e.g. "0.001234"
+		else if ( point <= 0 && point > -4 )
+		{
+			*c++ = '0';
+			*c++ = '.';
+			while ( point++ < 0 ) *c++ = '0';
+			while ( number_of_digits > 0 ) *c++ = d[--number_of_digits];
+		}
+
+	// ---- e.g. "1.234e-07" or "1.5e+12"
+		else
+		{
+			*c++ = d[--number_of_digits];
+			if ( number_of_digits > 0 )
+			{
+				*c++ = '.';
+				while ( number_of_digits > 0 ) *c++ = d[--number_of_digits];
+			}
+			INT e = point - 1;
+			*c++ = 'e';
+			*c++ = e < 0 ? '-' : '+';
+			e = e < 0 ? -e : e;
+			if ( e < 10 ) *c++ = '0';
+			c = FormatInt(c, e);
+		}
+
+	return c;
+}
+
+
+// ---------- FormatInt ----------
+/*!
+\brief format an INT, e.g. "12", "-3"
+\author Gareth Edwards
+\param CHAR *c [in] first character, room for at least 12
+\param INT value [in]
+\return CHAR * (first character after number)
+*/
+CHAR *DotObjUtilities::PI_DotObjUtilities::FormatInt
+		(
+			CHAR *c,             // [in]
+			INT value            // [in]
+		)
+{
+	UINT u = (UINT)value;
+	if ( value < 0 )
+	{
+		*c++ = '-';
+		u = 0 - u;
+	}
+	CHAR d[12];
+	INT  number_of_digits = 0;
+	do
+	{
+		d[number_of_digits++] = (CHAR)('0' + u % 10);
+		u /= 10;
+	} while ( u != 0 );
+	while ( number_of_digits > 0 ) *c++ = d[--number_of_digits];
+	return c;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- OpenWriter ----------
+/*!
+\brief create (or truncate) a file, and allocate a writer's blocks
+\author Gareth Edwards
+\param DotObjWriter *writer [out]
+\param CHAR *filename [in]
+\return HRESULT (SUCCESS_OK if ok)
+*/
+HRESULT DotObjUtilities::PI_DotObjUtilities::OpenWriter
+		(
+			DotObjWriter *writer,  // [out]
+			CHAR *filename         // [in]
+		)
+{
+
+	// ---- file
+		writer->_file = CreateFile(
+				filename,
+				GENERIC_WRITE,
+				0,
+				NULL,
+				CREATE_ALWAYS,
+				FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+				NULL
+			);
+		if ( writer->_file == INVALID_HANDLE_VALUE )
+		{
+			OutputDebugString("DotObjUtilities::Write - Error: file could not be opened \n");
+			return SUCCESS_FAULT;
+		}
+
+	// ---- blocks
+		writer->_threaded = _write_mode == DotObjUtilities::WriteMode::THREADED;
+		writer->_block[0].resize(DotObjWriter::BLOCK_SIZE);
+		if ( writer->_threaded ) writer->_block[1].resize(DotObjWriter::BLOCK_SIZE);
+		writer->_current = 0;
+		writer->_c = writer->_block[0].data();
+		writer->_ok = TRUE;
+		writer->_bytes = 0;
+
+	return SUCCESS_OK;
+}
+
+
+// ---------- Reserve ----------
+/*!
+\brief get room for at least # bytes in a writer's current block
+\author Gareth Edwards
+\param DotObjWriter *writer [in & out]
+\param INT bytes [in] <= BLOCK_SIZE
+\return CHAR * (first free character, to be returned via writer->_c)
+*/
+CHAR *DotObjUtilities::PI_DotObjUtilities::Reserve
+		(
+			DotObjWriter *writer,  // [in & out]
+			INT bytes              // [in]
+		)
+{
+	CHAR *begin = writer->_block[writer->_current].data();
+	if ( writer->_c + bytes > begin + DotObjWriter::BLOCK_SIZE ) FlushWriter(writer);
+	return writer->_c;
+}
+
+
+// ---------- FlushWriter ----------
+/*!
+\brief hand a writer's current block to the file, and start the next
+\author Gareth Edwards
+\param DotObjWriter *writer [in & out]
+\note THREADED waits for the previous block (if any) to be written,
+then writes this one in the background and swaps blocks
+*/
+VOID DotObjUtilities::PI_DotObjUtilities::FlushWriter
+		(
+			DotObjWriter *writer   // [in & out]
+		)
+{
+
+	// ---- local
+		CHAR *begin = writer->_block[writer->_current].data();
+		DWORD size = (DWORD)(writer->_c - begin);
+		if ( size == 0 ) return;
+
+	// ---- lambda: write a block
+		auto write_block = [](DotObjWriter *writer, const CHAR *begin, DWORD size)
+		{
+			DWORD written = 0;
+			if ( !WriteFile(writer->_file, begin, size, &written, NULL) || written != size )
+				writer->_ok = FALSE;
+		};
+
+	// ---- threaded
+		if ( writer->_threaded )
+		{
+			if ( writer->_flush.joinable() ) writer->_flush.join();
+			writer->_flush = std::thread(write_block, writer, begin, size);
+			writer->_current = 1 - writer->_current;
+		}
+
+	// ---- streamed
+		else
+		{
+			write_block(writer, begin, size);
+		}
+
+	// ---- next
+		writer->_bytes += size;
+		writer->_c = writer->_block[writer->_current].data();
+}
+
+
+// ---------- CloseWriter ----------
+/*!
+\brief flush a writer, wait for any background write, and close the file
+\author Gareth Edwards
+\param DotObjWriter *writer [in & out]
+\return HRESULT (SUCCESS_OK if every block was written)
+*/
+HRESULT DotObjUtilities::PI_DotObjUtilities::CloseWriter
+		(
+			DotObjWriter *writer   // [in & out]
+		)
+{
+	if ( writer->_file == INVALID_HANDLE_VALUE ) return SUCCESS_FAULT;
+	FlushWriter(writer);
+	if ( writer->_flush.joinable() ) writer->_flush.join();
+	CloseHandle(writer->_file);
+	writer->_file = INVALID_HANDLE_VALUE;
+	if ( !writer->_ok ) OutputDebugString("DotObjUtilities::Write - Error: file could not be written \n");
+	return writer->_ok ? SUCCESS_OK : SUCCESS_FAULT;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---------- mesh io write ----------
+
+
+// ---------- Write ----------
+/*!
+\brief write a flat mesh as a ".obj" format object data file
+\author Gareth Edwards
+\param DotObjMesh *mesh [in]
+\param CHAR *filename [in] ".obj" path/file name
+\return HRESULT (SUCCESS_OK if ok)
+\note faces are written as read (i.e. not triangulated), with 1 based
+indices and "v", "v/vt", "v//vn" or "v/vt/vn" corners
+*/
+HRESULT DotObjUtilities::Write(
+		DotObjMesh *mesh,
+		CHAR *filename
+	)
+{
+
+	// ---- check
+		if ( mesh == NULL ) return SUCCESS_FAULT;
+
+	// ---- local
+		PI_DotObjUtilities *pi = pi_dot_obj_utilities;
+		PI_DotObjUtilities::DotObjWriter writer;
+		HRESULT hr = pi->OpenWriter(&writer, filename);
+		if ( hr != SUCCESS_OK ) return hr;
+
+	// ---- lambda: write "tag x y z" lines, then annotate
+		auto write_vertices = [&](
+				DotObjElement::TagId tag_id,
+				const FLOAT *value,
+				INT number_of_vertices,
+				INT number_of_values
+			)
+		{
+			const CHAR *tag_name = pi->GetTagName(tag_id);
+			INT tag_len = (INT)strlen(tag_name);
+			for ( INT i = 0; i < number_of_vertices; i++ )
+			{
+				CHAR *c = pi->Reserve(&writer, 128);
+				memcpy(c, tag_name, tag_len);
+				c += tag_len;
+				for ( INT n = 0; n < number_of_values; n++ )
+				{
+					*c++ = ' ';
+					c = pi->FormatFloat(c, *value++);
+				}
+				*c++ = '\n';
+				writer._c = c;
+			}
+			if ( number_of_vertices != 0 )
+			{
+				CHAR *c = pi->Reserve(&writer, 128);
+				writer._c = c + sprintf_s(c, 128, "# %d %s\n\n", number_of_vertices, pi->GetTagLabel(tag_id));
+			}
+		};
+
+	// ---- vertices
+		write_vertices(DotObjElement::TagId::VERTEX_GEOMETRY, mesh->GetPositions(), mesh->GetNumberOfPositions(), 3);
+		write_vertices(DotObjElement::TagId::VERTEX_TEXTURE,  mesh->GetTexcoords(), mesh->GetNumberOfTexcoords(), 2);
+		write_vertices(DotObjElement::TagId::VERTEX_NORMAL,   mesh->GetNormals(),   mesh->GetNumberOfNormals(),   3);
+
+	// ---- faces
+		INT  number_of_faces = mesh->GetNumberOfFaces();
+		INT *face   = mesh->GetFaces();
+		INT *corner = mesh->GetCorners();
+		for ( INT f = 0; f < number_of_faces; f++ )
+		{
+			CHAR *c = pi->Reserve(&writer, 4);
+			*c++ = 'f';
+			writer._c = c;
+			for ( INT k = face[f]; k < face[f + 1]; k++ )
+			{
+				const INT *v = corner + k * 3;
+				c = pi->Reserve(&writer, 48);
+				*c++ = ' ';
+				c = pi->FormatInt(c, v[0] + 1);
+				if ( v[1] >= 0 || v[2] >= 0 )
+				{
+					*c++ = '/';
+					if ( v[1] >= 0 ) c = pi->FormatInt(c, v[1] + 1);
+					if ( v[2] >= 0 )
+					{
+						*c++ = '/';
+						c = pi->FormatInt(c, v[2] + 1);
+					}
+				}
+				writer._c = c;
+			}
+			c = pi->Reserve(&writer, 4);
+			*c++ = '\n';
+			writer._c = c;
+		}
+		if ( number_of_faces != 0 )
+		{
+			CHAR *c = pi->Reserve(&writer, 128);
+			writer._c = c + sprintf_s(c, 128, "# %d %s\n\n", number_of_faces,
+					pi->GetTagLabel(DotObjElement::TagId::ELEMENT_FACE));
+		}
+
+	return pi->CloseWriter(&writer);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
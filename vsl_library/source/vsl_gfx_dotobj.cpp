@@ -14,6 +14,10 @@
 	#include "../../vsl_library/header/vsl_gfx_dotobj.h"
 	#include "../../vsl_library/header/vsl_gfx_kandinsky.h"
 
+// ---- std
+	#include <algorithm> // partition, sort, heap, etc. (see bvh & lod hpp)
+	#include <float.h>   // FLT_MAX
+
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -44,6 +48,43 @@ class DotObjElement::PI_DotObjElement
 		INT   _number_of_values = 0;
 		FLOAT _value[4] = { 0, 0, 0, 0 };
 
+	// ---- arena
+		//
+		// note: the root of a tree owns a bump arena, created by its
+		// first Add, from which every node (& its pimpl) below it is
+		// allocated, so a tree is released in one shot when the root
+		// is destroyed - nodes below the root must NOT be deleted
+		//
+		struct Arena
+		{
+			enum { MIN_BLOCK_SIZE = 1 << 16, MAX_BLOCK_SIZE = 1 << 24 };
+			std::vector<BYTE *> _block;
+			BYTE  *_next = NULL;
+			BYTE  *_end  = NULL;
+			size_t _block_size = MIN_BLOCK_SIZE;
+			VOID *Allocate(size_t size)
+			{
+				size = ( size + 15 ) & ~(size_t)15;
+				if ( _next == NULL || _next + size > _end )
+				{
+					BYTE *block = new BYTE[_block_size];
+					_block.push_back(block);
+					_next = block;
+					_end  = block + _block_size;
+					_block_size = _block_size < MAX_BLOCK_SIZE ? _block_size * 2 : _block_size;
+				}
+				VOID *memory = _next;
+				_next += size;
+				return memory;
+			}
+			~Arena()
+			{
+				for ( auto block : _block ) delete[] block;
+			}
+		};
+		Arena *_arena = NULL;        // of the tree, shared by every node
+		BOOL   _arena_owner = FALSE; // TRUE for root only
+
 };
 
 
@@ -57,10 +98,16 @@ class DotObjElement::PI_DotObjElement
 		pi_dot_obj_element = new PI_DotObjElement();
 	}
 
+	DotObjElement::DotObjElement(PI_DotObjElement *pi)
+	{
+		pi_dot_obj_element = pi;
+	}
+
 	DotObjElement::~DotObjElement()
 	{
 		if ( pi_dot_obj_element != NULL )
 		{
+			if ( pi_dot_obj_element->_arena_owner ) delete pi_dot_obj_element->_arena;
 			delete pi_dot_obj_element;
 			pi_dot_obj_element = NULL;
 		}
@@ -70,7 +117,21 @@ class DotObjElement::PI_DotObjElement
 
 	DotObjElement *DotObjElement::Add(TagId tid)
 	{
-		DotObjElement *new_node = new DotObjElement();
+
+		// ---- root ? then create arena
+			if ( pi_dot_obj_element->_arena == NULL )
+			{
+				pi_dot_obj_element->_arena = new PI_DotObjElement::Arena();
+				pi_dot_obj_element->_arena_owner = TRUE;
+			}
+
+		// ---- allocate node & pimpl together
+			const size_t node_size = ( sizeof(DotObjElement) + 15 ) & ~(size_t)15;
+			BYTE *memory = (BYTE *)pi_dot_obj_element->_arena->Allocate(node_size + sizeof(PI_DotObjElement));
+			PI_DotObjElement *new_pi = new (memory + node_size) PI_DotObjElement();
+			DotObjElement *new_node = new (memory) DotObjElement(new_pi);
+			new_pi->_arena  = pi_dot_obj_element->_arena;
+			new_pi->_parent = this;
 
 		if ( pi_dot_obj_element->_first == NULL )
 		{
@@ -139,6 +200,267 @@ class DotObjElement::PI_DotObjElement
 ////////////////////////////////////////////////////////////////////////////////
 
 
+class DotObjMesh::PI_DotObjMesh
+{
+
+	public:
+
+	// ---- cdtor
+		PI_DotObjMesh::PI_DotObjMesh() {};
+		PI_DotObjMesh::~PI_DotObjMesh() {};
+
+	// ---- vertex data
+		std::vector<FLOAT> _positions;  // x, y, z
+		std::vector<FLOAT> _texcoords;  // u, v
+		std::vector<FLOAT> _normals;    // x, y, z
+
+	// ---- element data
+		std::vector<INT>   _corners;    // v, vt, vn (0 based, -1 if absent)
+		std::vector<INT>   _faces;      // offset of first corner, # faces + 1
+
+	// ---- triangle data
+		std::vector<INT>   _triangles;     // 3 corners per triangle
+
+	// ---- unique vertex data
+		std::vector<INT>   _unique;        // first corner of each unique vertex
+		std::vector<INT>   _corner_vertex; // unique vertex of each corner
+
+	// ---- bounds & bvh data
+		FLOAT _min[3] = {  FLT_MAX,  FLT_MAX,  FLT_MAX };
+		FLOAT _max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		std::vector<DotObjMesh::BvhNode> _bvh;          // depth first
+		std::vector<INT>                 _bvh_triangles; // leaf triangles
+
+	// ---- level of detail data
+		std::vector<INT>   _lod_first;   // first index of each lod, # lods + 1
+		std::vector<INT>   _lod_index;   // 3 unique vertices per triangle
+		std::vector<FLOAT> _lod_error;   // of each lod
+
+		VOID ClearLods()
+		{
+			_lod_first.clear();
+			_lod_index.clear();
+			_lod_error.clear();
+		}
+
+		VOID ClearBounds()
+		{
+			_min[0] = _min[1] = _min[2] =  FLT_MAX;
+			_max[0] = _max[1] = _max[2] = -FLT_MAX;
+			_bvh.clear();
+			_bvh_triangles.clear();
+		}
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+// ---- cdtor
+
+	DotObjMesh::DotObjMesh()
+	{
+		pi_dot_obj_mesh = new PI_DotObjMesh();
+		pi_dot_obj_mesh->_faces.push_back(0);
+	}
+
+	DotObjMesh::~DotObjMesh()
+	{
+		if ( pi_dot_obj_mesh != NULL )
+		{
+			delete pi_dot_obj_mesh;
+			pi_dot_obj_mesh = NULL;
+		}
+	}
+
+// ---- builder
+
+	VOID DotObjMesh::Clear()
+	{
+		pi_dot_obj_mesh->_positions.clear();
+		pi_dot_obj_mesh->_texcoords.clear();
+		pi_dot_obj_mesh->_normals.clear();
+		pi_dot_obj_mesh->_corners.clear();
+		pi_dot_obj_mesh->_faces.clear();
+		pi_dot_obj_mesh->_faces.push_back(0);
+		pi_dot_obj_mesh->_triangles.clear();
+		pi_dot_obj_mesh->_unique.clear();
+		pi_dot_obj_mesh->_corner_vertex.clear();
+		pi_dot_obj_mesh->ClearBounds();
+		pi_dot_obj_mesh->ClearLods();
+	}
+
+	VOID DotObjMesh::Reserve(INT positions, INT texcoords, INT normals, INT faces, INT corners)
+	{
+		pi_dot_obj_mesh->_positions.reserve(positions * 3);
+		pi_dot_obj_mesh->_texcoords.reserve(texcoords * 2);
+		pi_dot_obj_mesh->_normals.reserve(normals * 3);
+		pi_dot_obj_mesh->_faces.reserve(faces + 1);
+		pi_dot_obj_mesh->_corners.reserve(corners * 3);
+	}
+
+	VOID DotObjMesh::Resize(INT positions, INT texcoords, INT normals, INT faces, INT corners)
+	{
+		//
+		// note: sized arrays are filled in place (e.g. by parallel
+		// parse), so the last face offset is left for the filler
+		//
+		pi_dot_obj_mesh->_positions.resize(positions * 3);
+		pi_dot_obj_mesh->_texcoords.resize(texcoords * 2);
+		pi_dot_obj_mesh->_normals.resize(normals * 3);
+		pi_dot_obj_mesh->_faces.resize(faces + 1);
+		pi_dot_obj_mesh->_corners.resize(corners * 3);
+		pi_dot_obj_mesh->_triangles.clear();
+		pi_dot_obj_mesh->_unique.clear();
+		pi_dot_obj_mesh->_corner_vertex.clear();
+		pi_dot_obj_mesh->ClearBounds();
+		pi_dot_obj_mesh->ClearLods();
+	}
+
+	VOID DotObjMesh::Swap(DotObjMesh *mesh)
+	{
+		PI_DotObjMesh *pi = pi_dot_obj_mesh;
+		pi_dot_obj_mesh = mesh->pi_dot_obj_mesh;
+		mesh->pi_dot_obj_mesh = pi;
+	}
+
+	VOID DotObjMesh::ResizeNormals(INT normals)
+	{
+		pi_dot_obj_mesh->_normals.resize(normals * 3);
+	}
+
+	INT DotObjMesh::AddPosition(FLOAT x, FLOAT y, FLOAT z)
+	{
+		std::vector<FLOAT> &p = pi_dot_obj_mesh->_positions;
+		p.push_back(x);
+		p.push_back(y);
+		p.push_back(z);
+		return (INT)p.size() / 3 - 1;
+	}
+
+	INT DotObjMesh::AddTexcoord(FLOAT u, FLOAT v)
+	{
+		std::vector<FLOAT> &t = pi_dot_obj_mesh->_texcoords;
+		t.push_back(u);
+		t.push_back(v);
+		return (INT)t.size() / 2 - 1;
+	}
+
+	INT DotObjMesh::AddNormal(FLOAT x, FLOAT y, FLOAT z)
+	{
+		std::vector<FLOAT> &n = pi_dot_obj_mesh->_normals;
+		n.push_back(x);
+		n.push_back(y);
+		n.push_back(z);
+		return (INT)n.size() / 3 - 1;
+	}
+
+	INT DotObjMesh::AddFace()
+	{
+		//
+		// note: a face is closed by the next AddFace, so
+		// the last offset is always the # of corners
+		//
+		std::vector<INT> &f = pi_dot_obj_mesh->_faces;
+		f.push_back(f.back());
+		return (INT)f.size() - 2;
+	}
+
+	INT DotObjMesh::AddCorner(INT v, INT vt, INT vn)
+	{
+		std::vector<INT> &c = pi_dot_obj_mesh->_corners;
+		c.push_back(v);
+		c.push_back(vt);
+		c.push_back(vn);
+		pi_dot_obj_mesh->_faces.back()++;
+		return (INT)c.size() / 3 - 1;
+	}
+
+// ---- size
+
+	INT DotObjMesh::GetNumberOfPositions() { return (INT)pi_dot_obj_mesh->_positions.size() / 3; };
+	INT DotObjMesh::GetNumberOfTexcoords() { return (INT)pi_dot_obj_mesh->_texcoords.size() / 2; };
+	INT DotObjMesh::GetNumberOfNormals()   { return (INT)pi_dot_obj_mesh->_normals.size()   / 3; };
+	INT DotObjMesh::GetNumberOfFaces()     { return (INT)pi_dot_obj_mesh->_faces.size()     - 1; };
+	INT DotObjMesh::GetNumberOfCorners()   { return (INT)pi_dot_obj_mesh->_corners.size()   / 3; };
+
+// ---- data
+
+	FLOAT *DotObjMesh::GetPositions() { return pi_dot_obj_mesh->_positions.data(); };
+	FLOAT *DotObjMesh::GetTexcoords() { return pi_dot_obj_mesh->_texcoords.data(); };
+	FLOAT *DotObjMesh::GetNormals()   { return pi_dot_obj_mesh->_normals.data();   };
+	INT   *DotObjMesh::GetCorners()   { return pi_dot_obj_mesh->_corners.data();   };
+	INT   *DotObjMesh::GetFaces()     { return pi_dot_obj_mesh->_faces.data();     };
+
+// ---- triangles
+
+	VOID DotObjMesh::ResizeTriangles(INT triangles)
+	{
+		pi_dot_obj_mesh->_triangles.resize(triangles * 3);
+		pi_dot_obj_mesh->_bvh.clear();
+		pi_dot_obj_mesh->_bvh_triangles.clear();
+	}
+
+	INT  DotObjMesh::GetNumberOfTriangles() { return (INT)pi_dot_obj_mesh->_triangles.size() / 3; };
+	INT *DotObjMesh::GetTriangles()         { return pi_dot_obj_mesh->_triangles.data(); };
+
+// ---- unique vertices
+
+	VOID DotObjMesh::ResizeUnique(INT unique_vertices)
+	{
+		pi_dot_obj_mesh->_unique.resize(unique_vertices);
+		pi_dot_obj_mesh->_corner_vertex.resize(pi_dot_obj_mesh->_corners.size() / 3);
+		pi_dot_obj_mesh->ClearLods();
+	}
+
+	INT  DotObjMesh::GetNumberOfUniqueVertices() { return (INT)pi_dot_obj_mesh->_unique.size(); };
+	INT *DotObjMesh::GetUniqueVertices()         { return pi_dot_obj_mesh->_unique.data();        };
+	INT *DotObjMesh::GetCornerVertices()         { return pi_dot_obj_mesh->_corner_vertex.data(); };
+
+// ---- bounds & bvh
+
+	VOID DotObjMesh::SetBounds(const FLOAT *min, const FLOAT *max)
+	{
+		memcpy(pi_dot_obj_mesh->_min, min, 3 * sizeof(FLOAT));
+		memcpy(pi_dot_obj_mesh->_max, max, 3 * sizeof(FLOAT));
+	}
+
+	BOOL DotObjMesh::GetBounds(FLOAT *min, FLOAT *max)
+	{
+		memcpy(min, pi_dot_obj_mesh->_min, 3 * sizeof(FLOAT));
+		memcpy(max, pi_dot_obj_mesh->_max, 3 * sizeof(FLOAT));
+		return min[0] <= max[0];
+	}
+
+	VOID DotObjMesh::ResizeBvh(INT nodes, INT triangles)
+	{
+		pi_dot_obj_mesh->_bvh.resize(nodes);
+		pi_dot_obj_mesh->_bvh_triangles.resize(triangles);
+	}
+
+	INT                  DotObjMesh::GetNumberOfBvhNodes() { return (INT)pi_dot_obj_mesh->_bvh.size(); };
+	DotObjMesh::BvhNode *DotObjMesh::GetBvhNodes()         { return pi_dot_obj_mesh->_bvh.data(); };
+	INT                 *DotObjMesh::GetBvhTriangles()     { return pi_dot_obj_mesh->_bvh_triangles.data(); };
+
+// ---- levels of detail
+
+	VOID DotObjMesh::ResizeLods(INT lods, INT indices)
+	{
+		pi_dot_obj_mesh->_lod_first.resize(lods > 0 ? lods + 1 : 0);
+		pi_dot_obj_mesh->_lod_index.resize(indices);
+		pi_dot_obj_mesh->_lod_error.resize(lods);
+	}
+
+	INT    DotObjMesh::GetNumberOfLods() { return (INT)pi_dot_obj_mesh->_lod_error.size(); };
+	INT   *DotObjMesh::GetLodFirst()     { return pi_dot_obj_mesh->_lod_first.data(); };
+	INT   *DotObjMesh::GetLodIndices()   { return pi_dot_obj_mesh->_lod_index.data(); };
+	FLOAT *DotObjMesh::GetLodErrors()    { return pi_dot_obj_mesh->_lod_error.data(); };
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
 class DotObjUtilities::PI_DotObjUtilities
 {
 
@@ -185,6 +507,10 @@ class DotObjUtilities::PI_DotObjUtilities
 		DotObjElement::TagId GetTagId(
 				CHAR *tag_name                // [in]
 			);
+		DotObjElement::TagId GetTagId(
+				const CHAR *tag_name,         // [in]
+				INT len                       // [in]
+			);
 		DotObjElement *GetTagList(
 			DotObjElement *object,            // [in]
 			DotObjElement::TagId tag_id       // [in]
@@ -196,6 +522,10 @@ class DotObjUtilities::PI_DotObjUtilities
 				DotObjElement::TagId tag_id   // [in]
 			);
 
+	// ---- tag lists of the object being parsed (see ParseData), by tag id
+		DotObjElement *_tag_list_object = NULL;
+		DotObjElement *_tag_list[DotObjElement::TagId::UNDEFINED + 1];
+
 	// --- read
 		HRESULT Scrub
 			(
@@ -211,7 +541,279 @@ class DotObjUtilities::PI_DotObjUtilities
 				const INT len                 // [in]
 			);
 
-	// ---- debug stuff
+	// ---- read mode
+		DotObjUtilities::ReadMode _read_mode = DotObjUtilities::ReadMode::BUFFERED;
+
+	// ---- read only file view (see vsl_gfx_dotobj_mapped.hpp)
+		struct DotObjView
+		{
+			HANDLE      _file    = INVALID_HANDLE_VALUE;
+			HANDLE      _mapping = NULL;
+			const CHAR *_data    = NULL;
+			INT64       _size    = 0;
+		};
+		HRESULT MapView
+			(
+				DotObjView *view,             // [out]
+				CHAR *filename                // [in]
+			);
+		VOID UnmapView
+			(
+				DotObjView *view              // [in & out]
+			);
+
+	// ---- locale free numeric scan (see vsl_gfx_dotobj_scan.hpp)
+		FLOAT ScanFloat
+			(
+				const CHAR **c,               // [in & out]
+				const CHAR *end               // [in]
+			);
+		INT ScanInt
+			(
+				const CHAR **c,               // [in & out]
+				const CHAR *end               // [in]
+			);
+
+	// ---- chunk cursor (see vsl_gfx_dotobj_mapped.hpp)
+		struct DotObjCursor
+		{
+			enum { POSITIONS = 0, TEXCOORDS = 1, NORMALS = 2, FACES = 3, CORNERS = 4, COUNT_SIZE = 5 };
+			FLOAT *_positions   = NULL;
+			FLOAT *_texcoords   = NULL;
+			FLOAT *_normals     = NULL;
+			INT   *_faces       = NULL;
+			INT   *_corners     = NULL;
+			INT    _corner_base = 0;
+			INT    _base[COUNT_SIZE]  = { 0, 0, 0, 0, 0 }; // # in previous chunks
+			INT    _total[COUNT_SIZE] = { 0, 0, 0, 0, 0 }; // # in this chunk (census)
+			INT    _count[COUNT_SIZE] = { 0, 0, 0, 0, 0 }; // # written
+		};
+		DotObjElement::TagId ClassifyLine
+			(
+				const CHAR **c,               // [in & out]
+				const CHAR *end               // [in]
+			);
+		VOID CensusChunk
+			(
+				const CHAR *data,             // [in]
+				const CHAR *end,              // [in]
+				INT *count                    // [out]
+			);
+		HRESULT ParseChunk
+			(
+				DotObjCursor *cursor,         // [in & out]
+				const CHAR *data,             // [in]
+				const CHAR *end               // [in]
+			);
+
+	// ---- threads (see vsl_gfx_dotobj_parallel.hpp)
+		INT _number_of_threads = 1;
+		INT SplitView
+			(
+				const CHAR *data,             // [in]
+				INT64 size,                   // [in]
+				INT max_chunks,               // [in]
+				const CHAR **chunk            // [out] max_chunks + 1
+			);
+
+	// ---- benchmark (see vsl_gfx_dotobj_benchmark.hpp)
+		VOID CreateGridData
+			(
+				std::string *data,            // [out]
+				INT number_of_faces,          // [in]
+				BOOL bumpy                    // [in]
+			);
+
+	// ---- triangulation (see vsl_gfx_dotobj_triangulate.hpp)
+		struct DotObjPolygon
+		{
+			std::vector<const FLOAT *> _point; // xyz of each corner
+			std::vector<FLOAT> _uv;            // projected
+			std::vector<INT>   _prev;          // ear clipping list
+			std::vector<INT>   _next;
+			VOID Resize(INT n)
+			{
+				if ( (INT)_point.size() >= n ) return;
+				_point.resize(n);
+				_uv.resize(n * 2);
+				_prev.resize(n);
+				_next.resize(n);
+			}
+		};
+		INT TriangulatePolygon
+			(
+				DotObjPolygon *polygon,       // [in & out]
+				INT n,                        // [in]
+				INT *triangle                 // [out]
+			);
+
+	// ---- optimisation (see vsl_gfx_dotobj_optimise.hpp)
+		INT CountCacheMisses
+			(
+				const INT *index,             // [in]
+				INT number_of_indices,        // [in]
+				INT number_of_vertices,       // [in]
+				INT cache_size                // [in]
+			);
+		VOID OptimiseVertexCache
+			(
+				const INT *index,             // [in]
+				INT number_of_triangles,      // [in]
+				INT number_of_vertices,       // [in]
+				INT *triangle_order           // [out]
+			);
+
+	// ---- binary cache sidecar (see vsl_gfx_dotobj_cache.hpp)
+		BOOL _cache_mode = FALSE;
+		struct DotObjCacheHeader
+		{
+			enum { VERSION = 2 };             // change with layout
+			CHAR   _magic[4];                 // "VSOM"
+			UINT   _version;
+			UINT   _header_size;
+			INT    _count[DotObjCursor::COUNT_SIZE];
+			INT    _number_of_triangles;
+			INT64  _source_size;
+			UINT64 _checksum;                 // of arrays
+		};
+		VOID GetCacheFilename
+			(
+				std::string *cache_filename,  // [out]
+				CHAR *filename                // [in]
+			);
+		UINT64 Checksum
+			(
+				UINT64 hash,                  // [in]
+				const VOID *data,             // [in]
+				INT64 size                    // [in] multiple of 4
+			);
+		HRESULT ReadCache
+			(
+				DotObjMesh *mesh,             // [out]
+				CHAR *filename                // [in] ".obj" path/file name
+			);
+		HRESULT WriteCache
+			(
+				DotObjMesh *mesh,             // [in]
+				CHAR *filename                // [in] ".obj" path/file name
+			);
+
+	// ---- streaming write (see vsl_gfx_dotobj_write.hpp)
+		DotObjUtilities::WriteMode _write_mode = DotObjUtilities::WriteMode::STREAMED;
+		struct DotObjWriter
+		{
+			enum { BLOCK_SIZE = 1 << 22 };
+			HANDLE            _file     = INVALID_HANDLE_VALUE;
+			std::vector<CHAR> _block[2];              // [1] only if threaded
+			INT               _current  = 0;          // block being filled
+			CHAR             *_c        = NULL;       // first free character
+			BOOL              _threaded = FALSE;
+			std::thread       _flush;                 // writing the other block
+			BOOL              _ok       = TRUE;
+			INT64             _bytes    = 0;          // # flushed
+		};
+		CHAR *FormatFloat
+			(
+				CHAR *c,                      // [in]
+				FLOAT value                   // [in]
+			);
+		CHAR *FormatInt
+			(
+				CHAR *c,                      // [in]
+				INT value                     // [in]
+			);
+		HRESULT OpenWriter
+			(
+				DotObjWriter *writer,         // [out]
+				CHAR *filename                // [in]
+			);
+		CHAR *Reserve
+			(
+				DotObjWriter *writer,         // [in & out]
+				INT bytes                     // [in]
+			);
+		VOID FlushWriter
+			(
+				DotObjWriter *writer          // [in & out]
+			);
+		HRESULT CloseWriter
+			(
+				DotObjWriter *writer          // [in & out]
+			);
+
+	// ---- bounds & bvh (see vsl_gfx_dotobj_bvh.hpp)
+		BOOL _bvh_mode = FALSE;
+		struct DotObjBvhBuild
+		{
+			enum
+			{
+				BVH_BINS          = 16,      // SAH split planes + 1
+				BVH_LEAF_SIZE     = 4,       // always a leaf at or below
+				BVH_MAX_LEAF_SIZE = 16,      // never a leaf above
+				BVH_PARALLEL_SIZE = 1 << 16, // min # triangles to thread
+				BVH_MAX_DEPTH     = 32,      // median split at or below
+				BVH_STACK_SIZE    = 64       // > max depth (see RayCast)
+			};
+			std::vector<FLOAT> _box;         // min xyz, max xyz, per triangle
+			std::vector<FLOAT> _centroid;    // xyz, per triangle
+			std::vector<INT>   _index;       // triangles, in leaf order
+			INT                _parallel_depth = 0;
+		};
+		VOID BuildBvhNode
+			(
+				DotObjBvhBuild *build,                  // [in & out]
+				std::vector<DotObjMesh::BvhNode> *node, // [in & out]
+				INT first,                              // [in]
+				INT count,                              // [in]
+				INT depth                               // [in]
+			);
+
+	// ---- levels of detail (see vsl_gfx_dotobj_lod.hpp)
+		VOID SimplifyChain
+			(
+				const FLOAT *position,        // [in]
+				const INT *position_of,       // [in]
+				INT number_of_vertices,       // [in]
+				const INT *index,             // [in]
+				INT number_of_triangles,      // [in]
+				INT number_of_lods,           // [in]
+				const INT *target,            // [in]
+				std::vector<INT> *lod_index,  // [out]
+				std::vector<INT> *lod_first,  // [out]
+				std::vector<FLOAT> *lod_error // [out]
+			);
+
+	// ---- hot reload (see vsl_gfx_dotobj_watch.hpp)
+		struct DotObjStamp
+		{
+			FILETIME _time = { 0, 0 };              // last write
+			INT64    _size = -1;
+			BOOL operator==(const DotObjStamp &s) const
+			{
+				return CompareFileTime(&_time, &s._time) == 0 && _size == s._size;
+			}
+		};
+		struct DotObjWatcher
+		{
+			enum { TIMEOUT_MS = 1000, SETTLE_MS = 100 };
+			std::string          _filename;
+			DotObjStamp          _stamp;                 // as last read
+			BOOL                 _unique  = FALSE;       // CreateUniqueVertices
+			HANDLE               _stop    = NULL;        // event, set by Unwatch
+			HANDLE               _change  = INVALID_HANDLE_VALUE;
+			std::thread          _thread;
+			DotObjMesh *volatile _ready   = NULL;        // waiting for Reload
+			DotObjMesh *volatile _retired = NULL;        // swapped out by Reload
+			LONG volatile        _reloads = 0;
+		} _watcher;
+		BOOL GetFileStamp
+			(
+				const CHAR *filename,         // [in]
+				DotObjStamp *stamp            // [out]
+			);
+		VOID WatchThread();
+
+	// ---- # of each tag parsed by ParseData (v, vt & vn resolve relative indices)
 		INT v__count = 0;
 		INT vt_count = 0;
 		INT vn_count = 0;
@@ -234,17 +836,54 @@ DotObjElement::TagId DotObjUtilities::PI_DotObjUtilities::GetTagId(
 		CHAR *tag_name // [in]
 	)
 {
+	return GetTagId(tag_name, (INT)strlen(tag_name));
+}
+
+
+// ---------- GetTagId ----------
+/*!
+\brief get a ".obj" format object tag id
+\author Gareth Edwards
+\param const CHAR *tag_name [in] tag name (NOT terminated)
+\param INT len [in] of tag name
+\return DotObjElement::TagId (UNDEFINED if not a known tag)
+\note switch on the first (& second) character, as per _rosetta,
+so no string compare
+*/
+DotObjElement::TagId DotObjUtilities::PI_DotObjUtilities::GetTagId(
+		const CHAR *tag_name, // [in]
+		INT len               // [in]
+	)
+{
 
-	// ---- find tag id with given name
-		UINT num_type = sizeof(_rosetta) /
-			sizeof(PI_DotObjUtilities::DotObjList);
-		for (UINT t = 0; t<num_type; t++)
+	// ---- one character
+		if ( len == 1 )
 		{
-			if ( strcmp(_rosetta[t]._tag_name, tag_name) == 0 ) return _rosetta[t]._tag_id;
+			switch ( tag_name[0] )
+			{
+				case '#': return DotObjElement::TagId::COMMENT;
+				case 'v': return DotObjElement::TagId::VERTEX_GEOMETRY;
+				case 'f': return DotObjElement::TagId::ELEMENT_FACE;
+				case 'l': return DotObjElement::TagId::ELEMENT_LINE;
+				case 'p': return DotObjElement::TagId::ELEMENT_POINT;
+				default : break;
+			}
+		}
+
+	// ---- two characters
+		else if ( len == 2 && tag_name[0] == 'v' )
+		{
+			switch ( tag_name[1] )
+			{
+				case 't': return DotObjElement::TagId::VERTEX_TEXTURE;
+				case 'n': return DotObjElement::TagId::VERTEX_NORMAL;
+				case 'p': return DotObjElement::TagId::VERTEX_PARAMETER;
+				default : break;
+			}
 		}
 
 	// ---- otherwise UNDEFINED
-		return _rosetta[num_type-1]._tag_id;
+		return DotObjElement::TagId::UNDEFINED;
 }
 
 
@@ -254,6 +893,7 @@ DotObjElement::TagId DotObjUtilities::PI_DotObjUtilities::GetTagId(
 \author Gareth Edwards
 \param CHAR *tag_name [in] tag name
 \return DotObjElement *
+\note from _tag_list if object is being parsed (see ParseData)
 */
 DotObjElement * DotObjUtilities::PI_DotObjUtilities::GetTagList(
 		DotObjElement *object,       // in]
@@ -263,11 +903,14 @@ DotObjElement * DotObjUtilities::PI_DotObjUtilities::GetTagList(
 
 	// ---- check
 		if ( object == NULL) return NULL;
-		DotObjElement *first = object->GetFirst();
-		if ( object->GetFirst() == NULL ) return NULL;
+
+	// ---- being parsed ?
+		if ( object == _tag_list_object )
+			return tag_id >= DotObjElement::TagId::COMMENT && tag_id <= DotObjElement::TagId::UNDEFINED ?
+				_tag_list[tag_id] : NULL;
 
 	// ---- loop
-		DotObjElement *elem = first;
+		DotObjElement *elem = object->GetFirst();
 		while (elem)
 		{
 			DotObjElement::TagId tid = elem->GetTagId();
@@ -286,23 +929,16 @@ DotObjElement * DotObjUtilities::PI_DotObjUtilities::GetTagList(
 \author Gareth Edwards
 \param DotObjElement::TagId tag_id [in] tag id
 \return CHAR * tag label (e.g. "vertices")
-\note returns "" if tag id not matched
+\note returns UNDEFINED label if tag id not matched
+\note _rosetta & _tag_label are in tag id order
 */
 CHAR *DotObjUtilities::PI_DotObjUtilities::GetTagLabel(
 		DotObjElement::TagId tag_id // [in]
 	)
 {
-
-	// ---- find tag label with given id
-		UINT num_type = sizeof(_rosetta) /
-			sizeof(PI_DotObjUtilities::DotObjList);
-		for (UINT t = 0; t<num_type; t++)
-		{
-			if ( _rosetta[t]._tag_id == tag_id ) return &_tag_label[t][0];
-		}
-
-	// ---- otherwise UNDEFINED
-		return &_tag_label[num_type - 1][0];
+	INT t = tag_id >= DotObjElement::TagId::COMMENT && tag_id <= DotObjElement::TagId::UNDEFINED ?
+		tag_id - 1 : DotObjElement::TagId::UNDEFINED - 1;
+	return &_tag_label[t][0];
 }
 
 
@@ -313,22 +949,15 @@ CHAR *DotObjUtilities::PI_DotObjUtilities::GetTagLabel(
 \param DotObjElement::TagId tag_id [in] tag id
 \return CHAR * tag name
 \note returns DotObjElement::TagId::UNDEFINED "name" if not matched
+\note _rosetta is in tag id order
 */
 CHAR *DotObjUtilities::PI_DotObjUtilities::GetTagName(
 		DotObjElement::TagId tag_id // [in]
 	)
 {
-
-	// ---- find tag name with given id
-		UINT num_type = sizeof(_rosetta) /
-			sizeof(PI_DotObjUtilities::DotObjList);
-		for (UINT t = 0; t<num_type; t++)
-		{
-			if ( _rosetta[t]._tag_id == tag_id ) return &_rosetta[t]._tag_name[0];
-		}
-
-	// ---- otherwise UNDEFINED
-		return &_rosetta[num_type-1]._tag_name[0];
+	INT t = tag_id >= DotObjElement::TagId::COMMENT && tag_id <= DotObjElement::TagId::UNDEFINED ?
+		tag_id - 1 : DotObjElement::TagId::UNDEFINED - 1;
+	return &_rosetta[t]._tag_name[0];
 }
 
 
@@ -347,7 +976,9 @@ Scrub out:
  1. multiple ' '
  2. multiple '\n'
  3. bogus '\r'
- 4. " /" with '/'
+
+Only ever removes characters, so is safe in place ("//" is left as is,
+& scanned as an empty, 0, field by ParseLine).
 
 */
 HRESULT DotObjUtilities::PI_DotObjUtilities::Scrub
@@ -380,9 +1011,6 @@ HRESULT DotObjUtilities::PI_DotObjUtilities::Scrub
 				case '\r':
 					copy = FALSE;
 					break;
-				case '/':
-					if ( last_c == '/' ) data[++j] = '0';
-					break;
 				default:
 					break;
 			}
@@ -487,6 +1115,7 @@ DotObjUtilities::~DotObjUtilities()
 {
 	if ( pi_dot_obj_utilities != NULL )
 	{
+		Unwatch();
 		delete pi_dot_obj_utilities;
 		pi_dot_obj_utilities = NULL;
 	}
@@ -628,57 +1257,22 @@ HRESULT DotObjUtilities::Write(
 	)
 {
 
-	// ---- local
-		BOOL report = FALSE;
-
 	// ---- check
 		if ( object == NULL) return SUCCESS_FAULT;
 		DotObjElement *first = object->GetFirst();
 		if ( object->GetFirst() == NULL ) return SUCCESS_FAULT;
 
-	// ---- stream
-		std::ofstream output_stream;
-		output_stream.open(filename);
-		if (!output_stream )
-		{ // file couldn't be opened
-			OutputDebugString("DotObjUtilities::Write - Error: file could not be opened \n");
-			return SUCCESS_FAULT;
-		}
-
-	// ---- BIG buffer
-		INT output_buffer_size = 100000;
-		std::string output_buffer;
-		output_buffer.reserve(output_buffer_size);
+	// ---- stream (see vsl_gfx_dotobj_write.hpp)
+		PI_DotObjUtilities *pi = pi_dot_obj_utilities;
+		PI_DotObjUtilities::DotObjWriter writer;
+		HRESULT hr = pi->OpenWriter(&writer, filename);
+		if ( hr != SUCCESS_OK ) return hr;
 
-	// ---- lambda: write to BIG buffer
-		auto write_output_buffer = [report, output_buffer_size](
-				std::ofstream & output_stream,
-				std::string & output_buffer,
-				std::string buffer
-			)
+	// ---- lambda: annotate
+		auto write_annotation = [&](INT number, CHAR *tag_label)
 		{
-			if ( (INT)output_buffer.length() + (INT)buffer.length() + 1 >= output_buffer_size )
-			{
-				if ( report )
-				{
-					OutputDebugString(buffer.c_str());
-					OutputDebugString("\n");
-				}
-				output_stream << output_buffer;
-				output_buffer.resize(0);
-			}
-			output_buffer.append(buffer);
-			output_buffer.append(1, '\n');
-		};
-
-	// ---- lambda: flush & close BIG buffer
-		auto flush_output_buffer = [&](
-				std::ofstream & output_stream,
-				std::string & output_buffer
-			)
-		{
-			output_stream << output_buffer;
-			output_stream.close();
+			CHAR *c = pi->Reserve(&writer, 128);
+			writer._c = c + sprintf_s(c, 128, "# %d %s\n\n", number, tag_label);
 		};
 
 	// ---- tag
@@ -688,8 +1282,9 @@ HRESULT DotObjUtilities::Write(
 		
 			// ---- tag
 				DotObjElement::TagId tag_id = tags_list->GetTagId();
-				CHAR *tag_name = pi_dot_obj_utilities->GetTagName(tag_id);
-				CHAR *tag_label = pi_dot_obj_utilities->GetTagLabel(tag_id);
+				CHAR *tag_name = pi->GetTagName(tag_id);
+				CHAR *tag_label = pi->GetTagLabel(tag_id);
+				INT   tag_len = (INT)strlen(tag_name);
 
 			// ---- ?
 				switch ( tag_id )
@@ -707,41 +1302,31 @@ HRESULT DotObjUtilities::Write(
 							{
 
 								// ---- loop
-									CHAR c[128];
-									std::string buffer;
-									buffer.reserve(128);
 									DotObjElement *vertex = tags_list->GetFirst();
 									INT number_of_vertex = 0;
 									while ( vertex )
 									{
 
-										// ---- assemble
-											buffer.assign(tag_name);
+										// ---- output (at most 4 values)
+											CHAR *c = pi->Reserve(&writer, 128);
+											memcpy(c, tag_name, tag_len);
+											c += tag_len;
 											INT number_of_values = vertex->GetNumberOfValues();
 											for ( INT n=0; n<number_of_values; n++)
 											{
-												FLOAT v = vertex->GetFloatValue(n);
-												sprintf_s(c, 128, " %f", v);
-												buffer += c;
+												*c++ = ' ';
+												c = pi->FormatFloat(c, vertex->GetFloatValue(n));
 											}
+											*c++ = '\n';
+											writer._c = c;
+
 											++number_of_vertex;
 											vertex = vertex->GetNext();
-
-										// ---- output
-											write_output_buffer(output_stream, output_buffer, buffer);
 									}
 
 								// ---- annotate
 									if (number_of_vertex != 0)
-									{
-
-										// --- assemble
-											sprintf_s(c, 128, "# %d %s\n", number_of_vertex, tag_label);
-											buffer.assign(c);
-
-										// ---- output
-											write_output_buffer(output_stream, output_buffer, buffer);
-									}
+										write_annotation(number_of_vertex, tag_label);
 							}
 							break;
 
@@ -752,20 +1337,20 @@ HRESULT DotObjUtilities::Write(
 							{
 
 								// ---- loop
-									CHAR c[128];
-									std::string buffer;
-									buffer.reserve(128);
 									DotObjElement *element = tags_list->GetFirst();
 									INT number_of_elements = 0;
 									while ( element )
 									{
 
-										// ---- assemble
-											buffer.assign(tag_name);
+										// ---- output
+											CHAR *c = pi->Reserve(&writer, 16);
+											memcpy(c, tag_name, tag_len);
+											writer._c = c + tag_len;
 											DotObjElement *parts = element->GetFirst();
 											while ( parts )
 											{
-												buffer += " ";
+												c = pi->Reserve(&writer, 64);
+												*c++ = ' ';
 												INT number_of_values = parts->GetNumberOfValues();
 												for (INT n = 0; n < number_of_values; n++)
 												{
@@ -774,31 +1359,23 @@ HRESULT DotObjUtilities::Write(
 													//
 													// note: v == 0 is legal ( e.g. v/0/vn ) but must NOT be saved
 													//
-													if ( v == 0 ) c[0] = '\0'; else sprintf_s(c, 128, "%d", v);
-													if (!last_value) strcat_s(c, 128, "/");
-													buffer += c;
+													if ( v != 0 ) c = pi->FormatInt(c, v);
+													if ( !last_value ) *c++ = '/';
 												}
+												writer._c = c;
 												parts = parts->GetNext();
 											}
+											c = pi->Reserve(&writer, 4);
+											*c++ = '\n';
+											writer._c = c;
+
 											++number_of_elements;
 											element = element->GetNext();
-
-										// ---- output
-											write_output_buffer(output_stream, output_buffer, buffer);
-
 									}
 
 								// ---- annotate
 									if ( number_of_elements != 0 )
-									{
-
-										// ---- assemble
-											sprintf_s(c, 128, "# %d %s\n", number_of_elements, tag_label);
-											buffer.assign(c);
-
-										// ---- output
-											write_output_buffer(output_stream, output_buffer, buffer);
-									}
+										write_annotation(number_of_elements, tag_label);
 							}
 							break;
 
@@ -813,12 +1390,7 @@ HRESULT DotObjUtilities::Write(
 
 		}
 
-
-		// ---- output
-			flush_output_buffer(output_stream, output_buffer);
-
-
-	return SUCCESS_OK;
+	return pi->CloseWriter(&writer);
 }
 
 
@@ -1137,8 +1709,8 @@ INT DotObjUtilities::GetNumberOfTriangles(DotObjElement *object)
 				++number_of_indices;
 				indice = indice->GetNext();
 			}
-			number_of_triangles += number_of_indices > 3 ?
-				number_of_indices - 2 : 1;
+			number_of_triangles += number_of_indices > 2 ?
+				number_of_indices - 2 : 0;
 			face = face->GetNext();
 		}
 
@@ -1194,14 +1766,19 @@ INT DotObjUtilities::GetTriangleIndexBuffer(
 						if ( index_count >= index_total ) throw("index buffer: overflow");
 
 
-					// ---- for each indice
-						DotObjElement *indice = face->GetFirst();
-						while ( indice )
+					// ---- # of triangles (as per GetTriangleVertexBuffer)
+						INT number_of_indices = 0;
+						for ( DotObjElement *indice = face->GetFirst(); indice; indice = indice->GetNext() )
+							number_of_indices++;
+						INT number_of_face_vertices = number_of_indices > 2 ? ( number_of_indices - 2 ) * 3 : 0;
+
+					// ---- one index per triangle vertex
+						for ( INT i = 0; i < number_of_face_vertices; i++ )
 						{
+							if ( index_count >= index_total ) throw("index buffer: overflow");
 							*(ib) = index_count;
 							ib++;
 							index_count++;
-							indice = indice->GetNext();
 						}
 
 					face = face->GetNext();
@@ -1291,38 +1868,44 @@ INT DotObjUtilities::GetTriangleVertexBuffer(
 				FLOAT norm_x = 0, norm_y = 0, norm_z = 0;
 				FLOAT *vb = vertex_buffer;
 				BOOL  calculate_face_normal = normal_exists == TRUE ? FALSE : TRUE;
-				INT   geometry_index = 0, normal_index = 0, texture_index = 0;
 				vsl_system::Vsl_Vector3 n (0, 0, 0);
 
-			// ---- local geometry lut
-				INT geometry_total = 0;
-				DotObjElement *geometry_indices[100000];
-				DotObjElement *vertex = geometry_list->GetFirst();
-				while ( vertex )
+			// ---- lambda: fill a lut with the elements of a tag list
+				//
+				// note: heap luts (NOT fixed size stack arrays), so any # of
+				// vertices, and concurrent calls on different objects, are ok
+				//
+				auto fill_lut = [](std::vector<DotObjElement *> *lut, DotObjElement *list)
 				{
-					geometry_indices[geometry_total++] = vertex;
-					vertex = vertex->GetNext();
-				}
-
-			// ---- local normal lut
-				INT normal_total = 0;
-				DotObjElement *normal_indices[100000];
-				if ( normal_exists )
+					INT number_of_elements = 0;
+					for ( DotObjElement *e = list->GetFirst(); e; e = e->GetNext() ) number_of_elements++;
+					lut->reserve(number_of_elements);
+					for ( DotObjElement *e = list->GetFirst(); e; e = e->GetNext() ) lut->push_back(e);
+				};
+
+			// ---- lambda: get a lut element from a 1 based ".obj" index
+				auto get_lut = [](std::vector<DotObjElement *> &lut, INT index, CHAR *msg)
 				{
-					DotObjElement *normal = normal_list->GetFirst();
-					while ( normal )
-					{
-						normal_indices[normal_total++] = normal;
-						normal = normal->GetNext();
-					}
-				}
-
-			// ---- NEED TO CHECK index values throughout !!! ---- 
+					if ( index < 1 || index > (INT)lut.size() ) throw(msg);
+					return lut[index - 1];
+				};
+
+			// ---- local luts
+				std::vector<DotObjElement *> geometry_indices;
+				std::vector<DotObjElement *> normal_indices;
+				std::vector<DotObjElement *> texture_indices;
+				fill_lut(&geometry_indices, geometry_list);
+				if ( normal_exists )  fill_lut(&normal_indices, normal_list);
+				if ( texture_exists ) fill_lut(&texture_indices, texture_list);
+
+			// ---- per face work space, reused so there is no allocation per face
+				std::vector<DotObjElement *> face_indices;
+				std::vector<INT> face_triangles;
+				PI_DotObjUtilities::DotObjPolygon polygon;
 
 			// ---- for each face
 				DotObjElement *face = faces_list->GetFirst();
 				INT vertex_count = 0;
-				INT normal_count = 0;
 				while ( face )
 				{
 
@@ -1339,7 +1922,7 @@ INT DotObjUtilities::GetTriangleVertexBuffer(
 								DotObjElement *indice = face->GetFirst();
 								while ( indice && indices_count < 3)
 								{
-									indices_for_normal[indices_count++] = indice->GetIntValue(0) - 1;
+									indices_for_normal[indices_count++] = indice->GetIntValue(0);
 									indice = indice->GetNext();
 								}
 
@@ -1347,9 +1930,10 @@ INT DotObjUtilities::GetTriangleVertexBuffer(
 								if ( indices_count == 3 )
 								{
 
-									FLOAT *pa = geometry_indices[indices_for_normal[0]]->GetPtrToFloatValues();
-									FLOAT *pb = geometry_indices[indices_for_normal[1]]->GetPtrToFloatValues();
-									FLOAT *pc = geometry_indices[indices_for_normal[2]]->GetPtrToFloatValues();
+									CHAR *msg = "face element: geometry index out of range";
+									FLOAT *pa = get_lut(geometry_indices, indices_for_normal[0], msg)->GetPtrToFloatValues();
+									FLOAT *pb = get_lut(geometry_indices, indices_for_normal[1], msg)->GetPtrToFloatValues();
+									FLOAT *pc = get_lut(geometry_indices, indices_for_normal[2], msg)->GetPtrToFloatValues();
 										
 									vsl_system::Vsl_Vector3 b( *(pb+0) - *(pa+0), *(pb+1) - *(pa+1), *(pb+2) - *(pa+2));
 									vsl_system::Vsl_Vector3 c( *(pc+0) - *(pa+0), *(pc+1) - *(pa+1), *(pc+2) - *(pa+2));
@@ -1372,35 +1956,39 @@ INT DotObjUtilities::GetTriangleVertexBuffer(
 									throw("face element: less than 3 indices");
 								}
 
+							//
+							// note: the face normal is used as is, NOT added to the
+							// normal tag list, so the tree does not grow per face
+							//
 
-							// ---- add a vertex_normal to tag list
-								DotObjElement *normal = normal_list->Add(DotObjElement::TagId::VERTEX_NORMAL);
-								normal->SetFloatValue(0, n.x);
-								normal->SetFloatValue(1, n.y);
-								normal->SetFloatValue(2, n.z);
-								normal->SetNumberOfValues(3);
+						}
 
-							// --- set index (must be this for dotobj)
-								normal_index = normal_count + 1;
 
-							// --- store in lut
-								normal_indices[normal_index - 1] = normal;
+					// ---- indices, & their geometry
+						face_indices.clear();
+						for ( DotObjElement *indice = face->GetFirst(); indice; indice = indice->GetNext() )
+							face_indices.push_back(indice);
+						INT number_of_indices = (INT)face_indices.size();
+						polygon.Resize(number_of_indices);
+						for ( INT i = 0; i < number_of_indices; i++ )
+							polygon._point[i] = get_lut(geometry_indices, face_indices[i]->GetIntValue(0),
+								"face element: geometry index out of range")->GetPtrToFloatValues();
 
-							// --- increment
-								normal_total++;
-								normal_count++;
+					// ---- triangulate
+						face_triangles.resize(number_of_indices > 2 ? ( number_of_indices - 2 ) * 3 : 0);
+						INT number_of_face_triangles = pi_dot_obj_utilities->TriangulatePolygon(
+								&polygon, number_of_indices, face_triangles.data());
 
-						}
+					// ---- for each triangle corner
+						for ( INT t = 0; t < number_of_face_triangles * 3; t++ )
+						{
+							DotObjElement *indice = face_indices[face_triangles[t]];
 
+							// ---- buffer ok?
+								if ( vertex_count >= vertex_total ) throw("vertex buffer: overflow");
 
-					// ---- for each indice
-						DotObjElement *indice = face->GetFirst();
-						while ( indice )
-						{
-					
 							// ---- geometry
-								INT geometry_index = indice->GetIntValue(0);
-								DotObjElement *vertex = geometry_indices[geometry_index - 1];
+								DotObjElement *vertex = get_lut(geometry_indices, indice->GetIntValue(0), "face element: geometry index out of range");
 								*(vb + 0) = vertex->GetFloatValue(0)  * width  + x_off;
 								*(vb + 1) = vertex->GetFloatValue(1)  * height + y_off;
 								*(vb + 2) = vertex->GetFloatValue(2)  * depth  + z_off;
@@ -1409,15 +1997,13 @@ INT DotObjUtilities::GetTriangleVertexBuffer(
 								if ( normal_exists )
 								{
 									INT normal_index = indice->GetIntValue(2);
-									DotObjElement *normal = normal_indices[normal_index - 1];
+									DotObjElement *normal = get_lut(normal_indices, normal_index, "face element: normal index out of range");
 									*(vb + 3) = normal->GetFloatValue(0);
 									*(vb + 4) = normal->GetFloatValue(1);
 									*(vb + 5) = normal->GetFloatValue(2);
 								}
 								else
 								{
-									indice->SetIntValue(2, normal_index);
-									indice->SetNumberOfValues(2);
 									*(vb + 3) = n.x;
 									*(vb + 4) = n.y;
 									*(vb + 5) = n.z;
@@ -1429,7 +2015,7 @@ INT DotObjUtilities::GetTriangleVertexBuffer(
 									if ( texture_exists )
 									{
 										INT texture_index = indice->GetIntValue(1);
-										DotObjElement *texture = &texture_list[texture_index - 1];
+										DotObjElement *texture = get_lut(texture_indices, texture_index, "face element: texture index out of range");
 										*(vb + 6) = texture->GetFloatValue(0);
 										*(vb + 7) = texture->GetFloatValue(1);
 									}
@@ -1447,7 +2033,6 @@ INT DotObjUtilities::GetTriangleVertexBuffer(
 
 							// ---- housekeeping
 								++vertex_count;
-								indice = indice->GetNext();
 
 						}
 
@@ -1516,6 +2101,17 @@ HRESULT DotObjUtilities::ParseData(
 	)
 {
 
+	// ---- tag lists, looked up once (NOT per line)
+		PI_DotObjUtilities *pi = pi_dot_obj_utilities;
+		pi->_tag_list_object = NULL;
+		for ( INT t = 0; t <= DotObjElement::TagId::UNDEFINED; t++ )
+			pi->_tag_list[t] = pi->GetTagList(object, (DotObjElement::TagId)t);
+		pi->_tag_list_object = object;
+
+	// ---- # of each tag parsed (so relative indices are of this data)
+		pi->v__count = pi->vt_count = pi->vn_count = pi->vp_count = 0;
+		pi->ef_count = pi->el_count = pi->ep_count = 0;
+
 	// ---- data ?
 		INT index = 0;
 		int line_count = 0;
@@ -1550,6 +2146,9 @@ HRESULT DotObjUtilities::ParseData(
 			index++;
 		}
 
+	// ---- done
+		pi->_tag_list_object = NULL;
+
 	// ---- debug ?
 
 	return SUCCESS_OK;
@@ -1564,6 +2163,7 @@ HRESULT DotObjUtilities::ParseData(
 \param CHAR *data [in] pointer to line within data array
 \param INT len [in] lenght of line within the data array
 \return HRESULT (SUCCESS_OK if ok)
+\note negative (relative) face indices are stored as absolute, as per ParseChunk
 */
 HRESULT DotObjUtilities::ParseLine(
 		DotObjElement *object,
@@ -1606,7 +2206,7 @@ HRESULT DotObjUtilities::ParseLine(
 				DotObjElement::TagId tag_id = pi_dot_obj_utilities->GetTagId(word[0]);
 				// ( tag_id == DotObjElement::TagId::UNDEFINED ) throw (word[0]);
 
-			// ---- debug 
+			// ---- count (so v, vt & vn are the # preceding a face)
 				switch ( tag_id )
 				{
 					case (INT)DotObjElement::TagId::VERTEX_GEOMETRY:
@@ -1657,7 +2257,8 @@ HRESULT DotObjUtilities::ParseLine(
 								new_elem->SetNumberOfValues(word_count - 1);
 								for ( UINT w = 1; w < word_count; w++ )
 								{
-									new_elem->SetFloatValue( w - 1, (FLOAT)atof(word[w]) );
+									const CHAR *c = word[w];
+									new_elem->SetFloatValue( w - 1, pi_dot_obj_utilities->ScanFloat(&c, data + len) );
 								}
 							}
 							break;
@@ -1674,41 +2275,36 @@ HRESULT DotObjUtilities::ParseLine(
 									for (UINT w = 1; w < word_count; w++)
 									{
 
-										// ---- expand "//" to "/0/"
-											INT  word_len = (INT)strlen(word[w]);
-											CHAR expanded_word[256];
-											CHAR last_c = '/';
-											INT expanded_word_len = -1;
-											for (INT i = 0; i < word_len; i++)
+										// ---- scan "v/vt/vn" in place ("//" is an empty, 0, field)
+											INT  value[4] = { 0, 0, 0, 0 };
+											INT  number_of_values = 0;
+											const CHAR *c = word[w];
+											const CHAR *end = data + len;
+											while ( number_of_values < 4 )
 											{
-												CHAR this_c = word[w][i];
-												if ( last_c == '/' && this_c == '/')
-												{
-													expanded_word[++expanded_word_len] = '0';
-												}
-												expanded_word[++expanded_word_len] = this_c;
-												last_c = this_c;
+												value[number_of_values++] =
+													*c != '/' ? pi_dot_obj_utilities->ScanInt(&c, end) : 0;
+												if ( *c != '/' || *(c + 1) == 0 ) break;
+												c++;
 											}
-											expanded_word[++expanded_word_len] = '\0';
-
-										// ---- & split again...
-											CHAR *elem_word[64];
-											UINT  elem_word_count = 0;
-											INT result = pi_dot_obj_utilities->Split
-												(
-													elem_word,
-													&elem_word_count,
-													'/',
-													expanded_word,
-													expanded_word_len
-												);
+
+										// ---- resolve negative (relative) v, vt & vn indices,
+										//      against the # preceding this line
+											const INT preceding[3] =
+												{
+													pi_dot_obj_utilities->v__count,
+													pi_dot_obj_utilities->vt_count,
+													pi_dot_obj_utilities->vn_count
+												};
+											for ( INT ev = 0; ev < number_of_values && ev < 3; ev++ )
+												if ( value[ev] < 0 ) value[ev] += preceding[ev] + 1;
 
 										// ---- add elem part
 											DotObjElement *new_elem_part = new_elem->Add(tag_id);
-											new_elem_part->SetNumberOfValues(elem_word_count);
-											for (UINT ew = 0; ew < elem_word_count; ew++)
+											new_elem_part->SetNumberOfValues(number_of_values);
+											for ( INT ev = 0; ev < number_of_values; ev++ )
 											{
-												new_elem_part->SetIntValue(ew, (INT)atoi(elem_word[ew]));
+												new_elem_part->SetIntValue(ev, value[ev]);
 											}
 									}
 							}
@@ -1739,3 +2335,22 @@ HRESULT DotObjUtilities::ParseLine(
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include "../hpp_obj/vsl_gfx_dotobj_mesh.hpp"
+#include "../hpp_obj/vsl_gfx_dotobj_mapped.hpp"
+#include "../hpp_obj/vsl_gfx_dotobj_parallel.hpp"
+#include "../hpp_obj/vsl_gfx_dotobj_scan.hpp"
+#include "../hpp_obj/vsl_gfx_dotobj_cache.hpp"
+#include "../hpp_obj/vsl_gfx_dotobj_indexed.hpp"
+#include "../hpp_obj/vsl_gfx_dotobj_packed.hpp"
+#include "../hpp_obj/vsl_gfx_dotobj_triangulate.hpp"
+#include "../hpp_obj/vsl_gfx_dotobj_normals.hpp"
+#include "../hpp_obj/vsl_gfx_dotobj_optimise.hpp"
+#include "../hpp_obj/vsl_gfx_dotobj_bvh.hpp"
+#include "../hpp_obj/vsl_gfx_dotobj_lod.hpp"
+#include "../hpp_obj/vsl_gfx_dotobj_write.hpp"
+#include "../hpp_obj/vsl_gfx_dotobj_watch.hpp"
+#include "../hpp_obj/vsl_gfx_dotobj_benchmark.hpp"
+
+
+////////////////////////////////////////////////////////////////////////////////
+
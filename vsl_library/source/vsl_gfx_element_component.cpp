@@ -51,6 +51,17 @@ public:
 		LPDIRECT3DVERTEXBUFFER9 vertex_buffer = NULL;
 		LPDIRECT3DINDEXBUFFER9  index_buffer = NULL;
 
+	// ---- level of detail, each a range of the index buffer, 0 is full detail
+		struct Lod
+		{
+			UINT  start_index;
+			UINT  primitive_count;
+			FLOAT min_size;        // least projected size (pixels) to use
+		};
+		std::vector<Lod> lod;
+		D3DXVECTOR3 lod_centre = D3DXVECTOR3(0, 0, 0);
+		FLOAT       lod_radius = 0;
+
 };
 
 
@@ -121,4 +132,60 @@ VOID Gfx_Element_Component::SetConfigBitmask(UINT config_bitmask)
 
 
 
+// ---------- level of detail ----------
+
+UINT Gfx_Element_Component::GetNumberOfLods(VOID)
+{
+	return (UINT)pimpl_gfx_element_component->lod.size();
+}
+
+VOID Gfx_Element_Component::GetLod(UINT lod, UINT *start_index, UINT *primitive_count)
+{
+	auto &l = pimpl_gfx_element_component->lod[lod];
+	*start_index = l.start_index;
+	*primitive_count = l.primitive_count;
+}
+
+VOID Gfx_Element_Component::GetLodBounds(D3DXVECTOR3 *centre, FLOAT *radius)
+{
+	*centre = pimpl_gfx_element_component->lod_centre;
+	*radius = pimpl_gfx_element_component->lod_radius;
+}
+
+/*!
+\brief select the most detailed lod whose min size is <= projected size
+(else the least detailed)
+\author Gareth Edwards
+\param FLOAT projected_size [in] pixels
+\return UINT lod (0 is full detail)
+\note lods must be set in order of detail, and so of min size
+*/
+UINT Gfx_Element_Component::SelectLod(FLOAT projected_size)
+{
+	auto &lod = pimpl_gfx_element_component->lod;
+	UINT selected = 0;
+	for (UINT l = 1; l < lod.size() && projected_size < lod[l - 1].min_size; l++)
+	{
+		selected = l;
+	}
+	return selected;
+}
+
+HRESULT Gfx_Element_Component::SetLod(UINT lod, UINT start_index, UINT primitive_count, FLOAT min_size)
+{
+	auto &l = pimpl_gfx_element_component->lod;
+	if (lod > l.size()) return ERROR_FAIL;
+	if (lod == l.size()) l.push_back({ 0, 0, 0 });
+	l[lod] = { start_index, primitive_count, min_size };
+	return SUCCESS_OK;
+}
+
+VOID Gfx_Element_Component::SetLodBounds(D3DXVECTOR3 &centre, FLOAT radius)
+{
+	pimpl_gfx_element_component->lod_centre = centre;
+	pimpl_gfx_element_component->lod_radius = radius;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
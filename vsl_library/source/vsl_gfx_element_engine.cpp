@@ -1033,6 +1033,33 @@ HRESULT Gfx_Element_Engine::Element_Display(
 				}
 				else
 				{
+
+					// ---- level of detail ? (select by projected diameter of lod bounds)
+						UINT start_index = 0;
+						if (gfx_element_component->GetNumberOfLods() > 0)
+						{
+							D3DXVECTOR3 centre;
+							FLOAT radius;
+							gfx_element_component->GetLodBounds(&centre, &radius);
+
+							D3DXMATRIX *world = gfx_element_configure->GetMatrix();
+							D3DXMATRIX view, projection;
+							D3DVIEWPORT9 viewport;
+							device->GetTransform(D3DTS_VIEW, &view);
+							device->GetTransform(D3DTS_PROJECTION, &projection);
+							device->GetViewport(&viewport);
+
+							D3DXVECTOR3 axis(world->_11, world->_12, world->_13);
+							radius *= D3DXVec3Length(&axis);
+							D3DXVec3TransformCoord(&centre, &centre, world);
+							D3DXVec3TransformCoord(&centre, &centre, &view);
+
+							UINT lod = centre.z > radius ?
+								gfx_element_component->SelectLod(radius * projection._22 * viewport.Height / centre.z) :
+								0;
+							gfx_element_component->GetLod(lod, &start_index, &primitive_count);
+						}
+
 					LPDIRECT3DINDEXBUFFER9 *index_buffer = gfx_element_component->GetIndexBuffer();
 					hr = device->SetIndices(*index_buffer);
 					hr = device->DrawIndexedPrimitive(
@@ -1040,7 +1067,7 @@ HRESULT Gfx_Element_Engine::Element_Display(
 							0, // Base vertex index
 							0, // Min vertex index
 							size_of_index_buffer,
-							0, // Start index
+							start_index,
 							primitive_count
 						);
 				}
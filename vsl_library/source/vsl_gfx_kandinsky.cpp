@@ -7,6 +7,9 @@
 \author Gareth Edwards 
 */
 
+// ---- system
+	#include "../../vsl_system/header/vsl_maths.h"
+
 // ---- library
 	#include "../../vsl_library/header/vsl_gfx_kandinsky.h"
 
@@ -353,6 +356,31 @@ HRESULT Gfx_Kandinsky::SetVertexBufferSize(UINT vertex_buffer_size)
 }
 
 
+// ---------- packed vertex ----------
+
+
+UINT Gfx_Kandinsky::GetPackedVertexFormatSize(UINT packing)
+{
+	return vsl_system::Vsl_Vertex_Packing::GetStride(GetVertexFormat(), packing);
+}
+
+HRESULT Gfx_Kandinsky::GetPackedVertexBuffer(BYTE *packed_buffer, UINT packing, FLOAT *dequantise)
+{
+	UINT vertex_format_size = GetVertexFormatSize();
+	if (packed_buffer == NULL || vertex_format_size == 0) return ERROR_FAIL;
+	if (GetPackedVertexFormatSize(packing) == 0) return ERROR_FAIL; // e.g. XYZRHW
+	vsl_system::Vsl_Vertex_Packing::Pack(
+			pimpl_gfx_kandinsky->vertex_buffer,
+			GetVertexBufferSize() / vertex_format_size,
+			GetVertexFormat(),
+			packing,
+			packed_buffer,
+			dequantise
+		);
+	return SUCCESS_OK;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 
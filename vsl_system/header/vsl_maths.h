@@ -149,6 +149,442 @@ namespace vsl_system {
 	};
 
 
+////////////////////////////////////////////////////////////////////////////////
+
+
+	// ---- Vsl_Vertex_Packing ----
+	/*!
+	\brief compact vertex encode & decode
+	\author Gareth Edwards
+
+	\note
+
+	Packs a float vertex buffer, as per a d3d flexible vertex format (i.e.
+	VS_XYZ | VS_NORMAL [| VS_TEX1], or a Gfx_Kandinsky_Vertex_Format), into
+	a byte buffer, where each packing flag replaces one FLOAT component:
+
+		POSITION_16    - 4 x USHORT unorm, relative to the buffer AABB ( 8 bytes, w = 0)
+		NORMAL_OCT_16  - 2 x SHORT snorm, octahedral                  ( 4 bytes)
+		NORMAL_1010102 - 3 x 10 bit unorm, 2 bits unused              ( 4 bytes)
+		TEXCOORD_HALF  - 2 x 16 bit half float                        ( 4 bytes)
+
+	e.g. POSITION_16 | NORMAL_OCT_16 | TEXCOORD_HALF is 16 bytes a vertex,
+	half of 32. Diffuse & specular colours are copied as is, and packed
+	components are in the same order as the float components.
+
+	Positions are decoded as dequantise[0..2] + unorm * dequantise[3..5],
+	i.e. AABB minimum + (USHORT / 65535) * AABB extent, which a vertex
+	shader (or the world matrix) can do after a USHORT4N fetch.
+
+	*/
+	struct Vsl_Vertex_Packing
+	{
+
+	public:
+
+		enum Packing
+		{
+			POSITION_16    = 0x01,
+			NORMAL_OCT_16  = 0x02,
+			NORMAL_1010102 = 0x04,
+			TEXCOORD_HALF  = 0x08,
+		};
+
+		enum Format // as per d3d
+		{
+			XYZ      = 0x002,
+			NORMAL   = 0x010,
+			DIFFUSE  = 0x040,
+			SPECULAR = 0x080,
+			TEX1     = 0x100,
+		};
+
+
+		// ---- size
+
+			static UINT GetFloats(UINT format)
+			{
+				if ( !(format & XYZ) || (format & ~(XYZ | NORMAL | DIFFUSE | SPECULAR | TEX1)) ) return 0;
+				return 3 +
+					(format & NORMAL   ? 3 : 0) +
+					(format & DIFFUSE  ? 1 : 0) +
+					(format & SPECULAR ? 1 : 0) +
+					(format & TEX1     ? 2 : 0);
+			}
+
+			static UINT GetStride(UINT format, UINT packing)
+			{
+				if ( GetFloats(format) == 0 ) return 0;
+				if ( (packing & NORMAL_OCT_16) && (packing & NORMAL_1010102) ) return 0;
+				UINT stride = packing & POSITION_16 ? 8 : 12;
+				if ( format & NORMAL ) stride += packing & (NORMAL_OCT_16 | NORMAL_1010102) ? 4 : 12;
+				if ( format & DIFFUSE ) stride += 4;
+				if ( format & SPECULAR ) stride += 4;
+				if ( format & TEX1 ) stride += packing & TEXCOORD_HALF ? 4 : 8;
+				return stride;
+			}
+
+
+		// ---- half float
+
+			static USHORT FloatToHalf(FLOAT f)
+			{
+				UINT x;
+				memcpy(&x, &f, 4);
+				UINT sign = (x >> 16) & 0x8000;
+				UINT mant = x & 0x7fffff;
+				INT  exp  = (INT)((x >> 23) & 0xff) - 127 + 15;
+				if ( (x & 0x7fffffff) > 0x7f800000 ) return (USHORT)(sign | 0x7e00);
+				if ( exp >= 31 ) return (USHORT)(sign | 0x7c00);
+				if ( exp <= 0 )
+				{
+					if ( exp < -10 ) return (USHORT)sign;
+					mant |= 0x800000;
+					UINT shift = (UINT)(14 - exp);
+					UINT h = mant >> shift;
+					UINT rem = mant & ((1u << shift) - 1), half = 1u << (shift - 1);
+					if ( rem > half || (rem == half && (h & 1)) ) h++;
+					return (USHORT)(sign | h);
+				}
+				UINT h = ((UINT)exp << 10) | (mant >> 13);
+				UINT rem = mant & 0x1fff;
+				if ( rem > 0x1000 || (rem == 0x1000 && (h & 1)) ) h++; // may carry into exp
+				return (USHORT)(sign | h);
+			}
+
+			static FLOAT HalfToFloat(USHORT h)
+			{
+				UINT sign = ((UINT)h & 0x8000) << 16;
+				INT  exp  = (h >> 10) & 0x1f;
+				UINT mant = h & 0x3ff;
+				UINT x;
+				if ( exp == 0 )
+				{
+					if ( mant == 0 )
+					{
+						x = sign;
+					}
+					else
+					{
+						exp = 1;
+						while ( !(mant & 0x400) ) { mant <<= 1; exp--; }
+						x = sign | ((UINT)(exp + 127 - 15) << 23) | ((mant & 0x3ff) << 13);
+					}
+				}
+				else if ( exp == 31 )
+				{
+					x = sign | 0x7f800000 | (mant << 13);
+				}
+				else
+				{
+					x = sign | ((UINT)(exp + 127 - 15) << 23) | (mant << 13);
+				}
+				FLOAT f;
+				memcpy(&f, &x, 4);
+				return f;
+			}
+
+
+		// ---- normal
+
+			static VOID EncodeOctahedral(const FLOAT *n, SHORT *oct)
+			{
+				FLOAT sum = fabsf(n[0]) + fabsf(n[1]) + fabsf(n[2]);
+				FLOAT x = sum > 0 ? n[0] / sum : 0;
+				FLOAT y = sum > 0 ? n[1] / sum : 0;
+				if ( n[2] < 0 )
+				{
+					FLOAT ox = (1 - fabsf(y)) * (x >= 0 ? 1 : -1);
+					FLOAT oy = (1 - fabsf(x)) * (y >= 0 ? 1 : -1);
+					x = ox; y = oy;
+				}
+				oct[0] = (SHORT)floorf( (x < -1 ? -1 : x > 1 ? 1 : x) * 32767 + 0.5f );
+				oct[1] = (SHORT)floorf( (y < -1 ? -1 : y > 1 ? 1 : y) * 32767 + 0.5f );
+			}
+
+			static VOID DecodeOctahedral(const SHORT *oct, FLOAT *n)
+			{
+				FLOAT x = oct[0] / 32767.0f, y = oct[1] / 32767.0f;
+				FLOAT z = 1 - fabsf(x) - fabsf(y);
+				if ( z < 0 )
+				{
+					FLOAT ox = (1 - fabsf(y)) * (x >= 0 ? 1 : -1);
+					FLOAT oy = (1 - fabsf(x)) * (y >= 0 ? 1 : -1);
+					x = ox; y = oy;
+				}
+				Normalise(x, y, z, n);
+			}
+
+			static UINT Encode1010102(const FLOAT *n)
+			{
+				UINT q[3];
+				for ( INT i = 0; i < 3; i++ )
+				{
+					FLOAT u = n[i] * 0.5f + 0.5f;
+					q[i] = (UINT)floorf( (u < 0 ? 0 : u > 1 ? 1 : u) * 1023 + 0.5f );
+				}
+				return q[0] | (q[1] << 10) | (q[2] << 20);
+			}
+
+			static VOID Decode1010102(UINT packed, FLOAT *n)
+			{
+				Normalise(
+						( packed        & 0x3ff) / 1023.0f * 2 - 1,
+						((packed >> 10) & 0x3ff) / 1023.0f * 2 - 1,
+						((packed >> 20) & 0x3ff) / 1023.0f * 2 - 1,
+						n
+					);
+			}
+
+			static VOID Normalise(FLOAT x, FLOAT y, FLOAT z, FLOAT *n)
+			{
+				FLOAT len = sqrtf(x*x + y*y + z*z);
+				len = len > 0 ? len : 1;
+				n[0] = x / len; n[1] = y / len; n[2] = z / len;
+			}
+
+
+		// ---- buffer
+
+			static UINT Pack(
+					const FLOAT *vertex_buffer, // [in] GetFloats(format) FLOATs per vertex
+					UINT  vertex_count,         // [in]
+					UINT  format,               // [in] Format flags
+					UINT  packing,              // [in] Packing flags
+					BYTE *packed_buffer,        // [out] vertex_count * GetStride(format, packing) bytes
+					FLOAT *dequantise           // [out] AABB min x, y, z & extent x, y, z
+				)
+			{
+
+				// ---- stride
+					UINT stride = GetStride(format, packing);
+					if ( stride == 0 || vertex_buffer == NULL || packed_buffer == NULL ) return 0;
+					UINT floats = GetFloats(format);
+
+				// ---- AABB
+					FLOAT min[3] = { 0, 0, 0 }, max[3] = { 0, 0, 0 };
+					for ( UINT v = 0; v < vertex_count; v++ )
+					{
+						const FLOAT *p = vertex_buffer + v * floats;
+						for ( INT i = 0; i < 3; i++ )
+						{
+							if ( v == 0 || p[i] < min[i] ) min[i] = p[i];
+							if ( v == 0 || p[i] > max[i] ) max[i] = p[i];
+						}
+					}
+					FLOAT scale[3];
+					for ( INT i = 0; i < 3; i++ )
+					{
+						FLOAT extent = max[i] - min[i];
+						scale[i] = extent > 0 ? 65535 / extent : 0;
+						if ( dequantise != NULL )
+						{
+							dequantise[i]     = packing & POSITION_16 ? min[i] : 0;
+							dequantise[i + 3] = packing & POSITION_16 ? extent : 1;
+						}
+					}
+
+				// ---- for each vertex
+					for ( UINT v = 0; v < vertex_count; v++ )
+					{
+						const FLOAT *f = vertex_buffer + v * floats;
+						BYTE *b = packed_buffer + v * stride;
+
+						// ---- position
+							if ( packing & POSITION_16 )
+							{
+								USHORT q[4] = { 0, 0, 0, 0 };
+								for ( INT i = 0; i < 3; i++ )
+								{
+									FLOAT u = (f[i] - min[i]) * scale[i];
+									q[i] = (USHORT)floorf( (u > 65535 ? 65535 : u) + 0.5f );
+								}
+								memcpy(b, q, 8); b += 8;
+							}
+							else
+							{
+								memcpy(b, f, 12); b += 12;
+							}
+							f += 3;
+
+						// ---- normal
+							if ( format & NORMAL )
+							{
+								if ( packing & NORMAL_OCT_16 )
+								{
+									SHORT oct[2];
+									EncodeOctahedral(f, oct);
+									memcpy(b, oct, 4); b += 4;
+								}
+								else if ( packing & NORMAL_1010102 )
+								{
+									UINT n = Encode1010102(f);
+									memcpy(b, &n, 4); b += 4;
+								}
+								else
+								{
+									memcpy(b, f, 12); b += 12;
+								}
+								f += 3;
+							}
+
+						// ---- colours
+							if ( format & DIFFUSE )  { memcpy(b, f++, 4); b += 4; }
+							if ( format & SPECULAR ) { memcpy(b, f++, 4); b += 4; }
+
+						// ---- texture
+							if ( format & TEX1 )
+							{
+								if ( packing & TEXCOORD_HALF )
+								{
+									USHORT h[2] = { FloatToHalf(f[0]), FloatToHalf(f[1]) };
+									memcpy(b, h, 4);
+								}
+								else
+								{
+									memcpy(b, f, 8);
+								}
+							}
+					}
+
+				return vertex_count * stride;
+			}
+
+			static UINT Unpack(
+					const BYTE *packed_buffer,  // [in] as per Pack
+					UINT  vertex_count,         // [in]
+					UINT  format,               // [in] as per Pack
+					UINT  packing,              // [in] as per Pack
+					const FLOAT *dequantise,    // [in] as per Pack
+					FLOAT *vertex_buffer        // [out] GetFloats(format) FLOATs per vertex
+				)
+			{
+
+				// ---- stride
+					UINT stride = GetStride(format, packing);
+					if ( stride == 0 || vertex_buffer == NULL || packed_buffer == NULL || dequantise == NULL ) return 0;
+					UINT floats = GetFloats(format);
+
+				// ---- for each vertex
+					for ( UINT v = 0; v < vertex_count; v++ )
+					{
+						const BYTE *b = packed_buffer + v * stride;
+						FLOAT *f = vertex_buffer + v * floats;
+
+						// ---- position
+							if ( packing & POSITION_16 )
+							{
+								USHORT q[4];
+								memcpy(q, b, 8); b += 8;
+								for ( INT i = 0; i < 3; i++ )
+									f[i] = dequantise[i] + q[i] / 65535.0f * dequantise[i + 3];
+							}
+							else
+							{
+								memcpy(f, b, 12); b += 12;
+							}
+							f += 3;
+
+						// ---- normal
+							if ( format & NORMAL )
+							{
+								if ( packing & NORMAL_OCT_16 )
+								{
+									SHORT oct[2];
+									memcpy(oct, b, 4); b += 4;
+									DecodeOctahedral(oct, f);
+								}
+								else if ( packing & NORMAL_1010102 )
+								{
+									UINT n;
+									memcpy(&n, b, 4); b += 4;
+									Decode1010102(n, f);
+								}
+								else
+								{
+									memcpy(f, b, 12); b += 12;
+								}
+								f += 3;
+							}
+
+						// ---- colours
+							if ( format & DIFFUSE )  { memcpy(f++, b, 4); b += 4; }
+							if ( format & SPECULAR ) { memcpy(f++, b, 4); b += 4; }
+
+						// ---- texture
+							if ( format & TEX1 )
+							{
+								if ( packing & TEXCOORD_HALF )
+								{
+									USHORT h[2];
+									memcpy(h, b, 4);
+									f[0] = HalfToFloat(h[0]);
+									f[1] = HalfToFloat(h[1]);
+								}
+								else
+								{
+									memcpy(f, b, 8);
+								}
+							}
+					}
+
+				return vertex_count * floats;
+			}
+
+
+		// ---- round trip error
+
+			static VOID GetError(
+					const FLOAT *vertex_buffer, // [in] original
+					const FLOAT *decoded,       // [in] as per Unpack
+					UINT  vertex_count,         // [in]
+					UINT  format,               // [in]
+					FLOAT *error                // [out] max position distance, normal degrees & texcoord difference
+				)
+			{
+				UINT floats = GetFloats(format);
+				UINT normal = 3;
+				UINT texture = floats - 2;
+				error[0] = error[1] = error[2] = 0;
+				for ( UINT v = 0; v < vertex_count; v++ )
+				{
+					const FLOAT *a = vertex_buffer + v * floats;
+					const FLOAT *b = decoded + v * floats;
+
+					// ---- position
+						FLOAT dx = a[0] - b[0], dy = a[1] - b[1], dz = a[2] - b[2];
+						FLOAT distance = sqrtf(dx*dx + dy*dy + dz*dz);
+						error[0] = distance > error[0] ? distance : error[0];
+
+					// ---- normal (if not of zero length)
+						if ( format & NORMAL )
+						{
+							const FLOAT *na = a + normal, *nb = b + normal;
+							FLOAT cx = na[1]*nb[2] - na[2]*nb[1];
+							FLOAT cy = na[2]*nb[0] - na[0]*nb[2];
+							FLOAT cz = na[0]*nb[1] - na[1]*nb[0];
+							FLOAT sine   = sqrtf(cx*cx + cy*cy + cz*cz);
+							FLOAT cosine = na[0]*nb[0] + na[1]*nb[1] + na[2]*nb[2];
+							if ( sine > 0 || cosine > 0 )
+							{
+								FLOAT degrees = atan2f(sine, cosine) * 57.2957795f; // better than acos near 0
+								error[1] = degrees > error[1] ? degrees : error[1];
+							}
+						}
+
+					// ---- texture
+						if ( format & TEX1 )
+						{
+							FLOAT du = fabsf(a[texture] - b[texture]), dv = fabsf(a[texture + 1] - b[texture + 1]);
+							FLOAT d = du > dv ? du : dv;
+							error[2] = d > error[2] ? d : error[2];
+						}
+				}
+			}
+
+	};
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 